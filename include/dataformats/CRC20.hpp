@@ -0,0 +1,92 @@
+/**
+ * @file CRC20.hpp Computation of the CRC20 of WIB2 and DAPHNE frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_CRC20_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_CRC20_HPP_
+
+#include "dataformats/daphne/DAPHNEFrame.hpp"
+#include "dataformats/wib2/WIB2Frame.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dunedaq::dataformats {
+
+/**
+ * @brief Generator polynomial of the frame CRC20, without its x^20 term
+ *
+ * The CRC is computed most significant bit first, starting from zero and with no final XOR, over the bytes of the
+ * frame as they are in memory: the header, then the ADC words. The frame definitions in EDMS documents 2088713 and
+ * 2088726 only give the width of the crc20 field, so these parameters are this implementation's choice and have not
+ * been checked against the firmware or against a real frame.
+ *
+ * Until they are, the CRC20 computed here only matches trailers written by fill_crc20(), e.g. in emulators, and
+ * must not be used to reject frames received from hardware.
+ */
+constexpr uint32_t s_crc20_polynomial = 0x8359F; // NOLINT(build/unsigned)
+
+/**
+ * @brief Bits of a CRC20 value
+ */
+constexpr uint32_t s_crc20_mask = 0xFFFFF; // NOLINT(build/unsigned)
+
+/**
+ * @brief Compute the CRC20 of a byte range
+ * @param data First byte
+ * @param size Number of bytes
+ * @param crc CRC20 of the bytes preceding the range, to compute the CRC20 of data split in several ranges
+ * @return CRC20 of the preceding bytes and the range
+ */
+uint32_t // NOLINT(build/unsigned)
+compute_crc20(const void* data, size_t size, uint32_t crc = 0) noexcept; // NOLINT(build/unsigned)
+
+/**
+ * @brief Compute the CRC20 of a WIB2Frame
+ * @param frame Frame whose header and ADC words to check
+ * @return Value for WIB2Frame::Trailer::crc20
+ */
+inline uint32_t // NOLINT(build/unsigned)
+compute_crc20(const WIB2Frame& frame) noexcept
+{
+  return compute_crc20(&frame, sizeof(frame));
+}
+
+/**
+ * @brief Compute the CRC20 of a DAPHNEFrame
+ * @param frame Frame whose header and ADC words to check
+ * @return Value for DAPHNEFrame::Trailer::crc20
+ */
+inline uint32_t // NOLINT(build/unsigned)
+compute_crc20(const DAPHNEFrame& frame) noexcept
+{
+  return compute_crc20(&frame, sizeof(frame));
+}
+
+/**
+ * @brief Write the CRC20 of consecutive WIB2Frames into their trailers, e.g. in emulators
+ *
+ * The trailer is stripped during transmission, so it is not part of WIB2Frame and is kept by the caller.
+ *
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param trailers Trailers of the frames, one per frame; only their crc20 fields are written
+ */
+void
+fill_crc20(const WIB2Frame* frames, size_t num_frames, WIB2Frame::Trailer* trailers) noexcept;
+
+/**
+ * @brief Write the CRC20 of consecutive DAPHNEFrames into their trailers, e.g. in emulators
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param trailers Trailers of the frames, one per frame; only their crc20 fields are written
+ */
+void
+fill_crc20(const DAPHNEFrame* frames, size_t num_frames, DAPHNEFrame::Trailer* trailers) noexcept;
+
+} // namespace dunedaq::dataformats
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_CRC20_HPP_
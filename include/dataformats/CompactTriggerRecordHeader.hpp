@@ -0,0 +1,427 @@
+/**
+ * @file CompactTriggerRecordHeader.hpp  CompactTriggerRecordHeader class definition
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_COMPACTTRIGGERRECORDHEADER_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_COMPACTTRIGGERRECORDHEADER_HPP_
+
+#include "dataformats/ComponentRequest.hpp"
+#include "dataformats/GeoID.hpp"
+#include "dataformats/TriggerRecordHeader.hpp"
+#include "dataformats/TriggerRecordHeaderBuilder.hpp"
+#include "dataformats/TriggerRecordHeaderData.hpp"
+#include "dataformats/Types.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Alternative encoding of a TriggerRecordHeader for records with many components sharing one window
+ *
+ * The flat array consists of a TriggerRecordHeaderData (with a distinct marker), a SharedWindow, one packed
+ * 64-bit GeoID per component and a list of WindowExceptions for the components whose window differs from the
+ * shared one. ComponentRequests are expanded on the fly by at(), or all at once by to_trigger_record_header().
+ *
+ * The TriggerRecordHeaderData is stored whole, but each component is reduced to its GeoID key and window: the
+ * version and unused fields of the GeoIDs and ComponentRequests are not encoded, and are expanded with their
+ * current default values.
+ */
+class CompactTriggerRecordHeader
+{
+public:
+  /**
+   * @brief Magic bytes used in the trigger_record_header_marker field to identify the compact encoding
+   */
+  static constexpr uint32_t s_compact_trigger_record_header_magic = 0x33335555; // NOLINT(build/unsigned)
+
+  /**
+   * @brief The current version of the compact encoding (stored in SharedWindow)
+   */
+  static constexpr uint32_t s_compact_trigger_record_header_version = 1; // NOLINT(build/unsigned)
+
+  /**
+   * @brief The window used by all components that do not have a WindowException
+   */
+  struct SharedWindow
+  {
+    uint32_t version{ s_compact_trigger_record_header_version }; ///< Version of the compact encoding // NOLINT
+    uint32_t unused{ 0xFFFFFFFF };         ///< Padding to ensure 64b alignment // NOLINT(build/unsigned)
+    timestamp_t window_begin{ TypeDefaults::s_invalid_timestamp }; ///< Start of the shared window
+    timestamp_t window_end{ TypeDefaults::s_invalid_timestamp };   ///< End of the shared window
+    uint64_t num_window_exceptions{ 0 }; ///< Number of WindowExceptions in the array // NOLINT(build/unsigned)
+  };
+
+  /**
+   * @brief The window of a component that differs from the SharedWindow
+   */
+  struct WindowException
+  {
+    uint64_t index{ 0 }; ///< Index of the component this window belongs to // NOLINT(build/unsigned)
+    timestamp_t window_begin{ TypeDefaults::s_invalid_timestamp }; ///< Start of the component's window
+    timestamp_t window_end{ TypeDefaults::s_invalid_timestamp };   ///< End of the component's window
+  };
+
+  /**
+   * @brief Encode an existing TriggerRecordHeader
+   * @param header TriggerRecordHeader to encode
+   *
+   * The most common window (if any window is used by the majority of components) becomes the shared window
+   */
+  explicit CompactTriggerRecordHeader(TriggerRecordHeader const& header)
+  {
+    auto num_components = header.get_num_requested_components();
+
+    // Boyer-Moore majority vote for the shared window
+    SharedWindow shared;
+    size_t votes = 0;
+    for (auto const& component : header) {
+      if (votes == 0) {
+        shared.window_begin = component.window_begin;
+        shared.window_end = component.window_end;
+      }
+      if (component.window_begin == shared.window_begin && component.window_end == shared.window_end) {
+        ++votes;
+      } else {
+        --votes;
+      }
+    }
+    for (auto const& component : header) {
+      if (component.window_begin != shared.window_begin || component.window_end != shared.window_end) {
+        ++shared.num_window_exceptions;
+      }
+    }
+
+    size_t size = get_total_size_bytes_(num_components, shared.num_window_exceptions);
+    m_data_arr = malloc(size);
+    if (m_data_arr == nullptr) {
+      throw MemoryAllocationFailed(ERS_HERE, size);
+    }
+    m_alloc = true;
+
+    TriggerRecordHeaderData header_data = header.get_header();
+    header_data.trigger_record_header_marker = s_compact_trigger_record_header_magic;
+    memcpy(m_data_arr, &header_data, sizeof(header_data));
+    memcpy(shared_window_(), &shared, sizeof(shared));
+
+    auto packed = packed_components_();
+    auto exception = window_exceptions_();
+    uint64_t idx = 0; // NOLINT(build/unsigned)
+    for (auto const& component : header) {
+      packed[idx] = component.component.get_key();
+      if (component.window_begin != shared.window_begin || component.window_end != shared.window_end) {
+        exception->index = idx;
+        exception->window_begin = component.window_begin;
+        exception->window_end = component.window_end;
+        ++exception;
+      }
+      ++idx;
+    }
+  }
+
+  /**
+   * @brief Construct a CompactTriggerRecordHeader using an existing compact data array
+   * @param existing_compact_header_buffer Pointer to existing CompactTriggerRecordHeader array
+   * @param copy_from_buffer Whether to create a copy of the exiting buffer (true) or use that memory without taking
+   * ownership (false)
+   */
+  explicit CompactTriggerRecordHeader(void* existing_compact_header_buffer, bool copy_from_buffer = false)
+  {
+    if (!copy_from_buffer) {
+      m_data_arr = existing_compact_header_buffer;
+    } else {
+      auto header = static_cast<TriggerRecordHeaderData*>(existing_compact_header_buffer);
+      auto shared = reinterpret_cast<SharedWindow*>(header + 1); // NOLINT
+      size_t size = get_total_size_bytes_(header->num_requested_components, shared->num_window_exceptions);
+
+      m_data_arr = malloc(size);
+      if (m_data_arr == nullptr) {
+        throw MemoryAllocationFailed(ERS_HERE, size);
+      }
+      m_alloc = true;
+      memcpy(m_data_arr, existing_compact_header_buffer, size);
+    }
+  }
+
+  /**
+   * @brief CompactTriggerRecordHeader copy constructor
+   * @param other CompactTriggerRecordHeader to copy
+   */
+  CompactTriggerRecordHeader(CompactTriggerRecordHeader const& other)
+    : CompactTriggerRecordHeader(other.m_data_arr, true)
+  {}
+  /**
+   * @brief CompactTriggerRecordHeader copy assignment operator
+   * @param other CompactTriggerRecordHeader to copy
+   * @return Reference to CompactTriggerRecordHeader copy
+   */
+  CompactTriggerRecordHeader& operator=(CompactTriggerRecordHeader const& other)
+  {
+    if (&other != this) {
+      *this = CompactTriggerRecordHeader(other);
+    }
+    return *this;
+  }
+  /**
+   * @brief CompactTriggerRecordHeader move constructor
+   * @param other CompactTriggerRecordHeader to move from. It no longer refers to any data array afterwards
+   */
+  CompactTriggerRecordHeader(CompactTriggerRecordHeader&& other) noexcept
+    : m_data_arr(std::exchange(other.m_data_arr, nullptr))
+    , m_alloc(std::exchange(other.m_alloc, false))
+  {}
+  /**
+   * @brief CompactTriggerRecordHeader move assignment operator
+   * @param other CompactTriggerRecordHeader to move from. It no longer refers to any data array afterwards
+   * @return Reference to this CompactTriggerRecordHeader
+   */
+  CompactTriggerRecordHeader& operator=(CompactTriggerRecordHeader&& other) noexcept
+  {
+    if (&other != this) {
+      if (m_alloc)
+        free(m_data_arr);
+      m_data_arr = std::exchange(other.m_data_arr, nullptr);
+      m_alloc = std::exchange(other.m_alloc, false);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief CompactTriggerRecordHeader destructor
+   */
+  ~CompactTriggerRecordHeader()
+  {
+    if (m_alloc)
+      free(m_data_arr);
+  }
+
+  /**
+   * @brief Check whether a flat TriggerRecordHeader array uses the compact encoding
+   * @param buffer Pointer to a TriggerRecordHeader or CompactTriggerRecordHeader data array
+   * @return Whether the marker word identifies the compact encoding
+   */
+  static bool is_compact(const void* buffer)
+  {
+    return static_cast<const TriggerRecordHeaderData*>(buffer)->trigger_record_header_marker ==
+           s_compact_trigger_record_header_magic;
+  }
+
+  /**
+   * @brief Expand into a regular TriggerRecordHeader
+   *
+   * The result is identical to the encoded TriggerRecordHeader only if the version and unused fields of its
+   * GeoIDs and ComponentRequests had their default values, since those are not encoded.
+   *
+   * @return TriggerRecordHeader with the same TriggerRecordHeaderData, GeoIDs and windows
+   */
+  TriggerRecordHeader to_trigger_record_header() const
+  {
+    auto num_components = get_num_requested_components();
+    TriggerRecordHeaderBuilder builder(num_components);
+    for (size_t idx = 0; idx < num_components; ++idx) {
+      builder.emplace_back(GeoID::from_key(packed_components_()[idx]),
+                           shared_window_()->window_begin,
+                           shared_window_()->window_end);
+    }
+    auto exceptions = window_exceptions_();
+    for (size_t i = 0; i < shared_window_()->num_window_exceptions; ++i) {
+      builder[exceptions[i].index].window_begin = exceptions[i].window_begin;
+      builder[exceptions[i].index].window_end = exceptions[i].window_end;
+    }
+
+    TriggerRecordHeaderData header_data = *header_();
+    header_data.trigger_record_header_marker = TriggerRecordHeaderData::s_trigger_record_header_magic;
+    builder.set_header(header_data);
+    return builder.build();
+  }
+
+  /**
+   * @brief Get a copy of the TriggerRecordHeaderData struct
+   * @return A copy of the TriggerRecordHeaderData struct stored in this CompactTriggerRecordHeader
+   */
+  TriggerRecordHeaderData get_header() const { return *header_(); }
+
+  /**
+   * @brief Get the trigger number for this CompactTriggerRecordHeader
+   * @return The trigger_number TriggerRecordHeaderData field
+   */
+  trigger_number_t get_trigger_number() const { return header_()->trigger_number; }
+  /**
+   * @brief Set the trigger number for this CompactTriggerRecordHeader
+   * @param trigger_number Trigger nunmber to set
+   */
+  void set_trigger_number(trigger_number_t trigger_number) { header_()->trigger_number = trigger_number; }
+  /**
+   * @brief Get the trigger_timestamp stored in this CompactTriggerRecordHeader
+   * @return The trigger_timestamp TriggerRecordHeaderData field
+   */
+  timestamp_t get_trigger_timestamp() const { return header_()->trigger_timestamp; }
+  /**
+   * @brief Set the trigger timestamp for this CompactTriggerRecordHeader
+   * @param trigger_timestamp Trigger timestamp to set
+   */
+  void set_trigger_timestamp(timestamp_t trigger_timestamp) { header_()->trigger_timestamp = trigger_timestamp; }
+  /**
+   * @brief Get the number of ComponentRequests stored in this CompactTriggerRecordHeader
+   * @return The num_requested_components TriggerRecordHeaderData field
+   */
+  uint64_t get_num_requested_components() const // NOLINT(build/unsigned)
+  {
+    return header_()->num_requested_components;
+  }
+  /**
+   * @brief Get the run_number stored in this CompactTriggerRecordHeader
+   * @return The run_number TriggerRecordHeaderData field
+   */
+  run_number_t get_run_number() const { return header_()->run_number; }
+  /**
+   * @brief Set the run number for this CompactTriggerRecordHeader
+   * @param run_number Run number to set
+   */
+  void set_run_number(run_number_t run_number) { header_()->run_number = run_number; }
+  /**
+   * @brief Get the error_bits header field as a bitset
+   * @return bitset containing error_bits header field
+   */
+  std::bitset<32> get_error_bits() const { return header_()->error_bits; }
+  /**
+   * @brief Overwrite error bits using the given bitset
+   * @param bits Bitset of error bits to set
+   */
+  void set_error_bits(std::bitset<32> bits) { header_()->error_bits = bits.to_ulong(); }
+  /**
+   * @brief Get the trigger_type field from the data struct
+   * @return The trigger_type field from the TriggerRecordHeaderData struct
+   */
+  trigger_type_t get_trigger_type() const { return header_()->trigger_type; }
+  /**
+   * @brief Set the trigger_type header field to the given value
+   * @param trigger_type Value of trigger_type to set
+   */
+  void set_trigger_type(trigger_type_t trigger_type) { header_()->trigger_type = trigger_type; }
+  /**
+   * @brief Get the sequence number for this CompactTriggerRecordHeader
+   * @return The sequence_number TriggerRecordHeaderData field
+   */
+  sequence_number_t get_sequence_number() const { return header_()->sequence_number; }
+  /**
+   * @brief Set the sequence number for this CompactTriggerRecordHeader
+   * @param number Sequence number to set
+   */
+  void set_sequence_number(sequence_number_t number) { header_()->sequence_number = number; }
+  /**
+   * @brief Get the maximum sequence number for this CompactTriggerRecordHeader
+   * @return The max_sequence_number TriggerRecordHeaderData field
+   */
+  sequence_number_t get_max_sequence_number() const { return header_()->max_sequence_number; }
+  /**
+   * @brief Set the maxiumum sequence number for this CompactTriggerRecordHeader
+   * @param number Maximum sequence number to set
+   */
+  void set_max_sequence_number(sequence_number_t number) { header_()->max_sequence_number = number; }
+
+  /**
+   * @brief Get the window shared by all components without a WindowException
+   * @return Copy of the SharedWindow struct
+   */
+  SharedWindow get_shared_window() const { return *shared_window_(); }
+
+  /**
+   * @brief Get the total size of the CompactTriggerRecordHeader
+   * @return The size of the CompactTriggerRecordHeader data array
+   */
+  size_t get_total_size_bytes() const
+  {
+    return get_total_size_bytes_(header_()->num_requested_components, shared_window_()->num_window_exceptions);
+  }
+  /**
+   * @brief Get the location of the flat data array for output
+   * @return Pointer to the CompactTriggerRecordHeader data array
+   */
+  const void* get_storage_location() const { return m_data_arr; }
+
+  /**
+   * @brief Expand the ComponentRequest at the given index
+   * @param idx Index to access
+   * @return ComponentRequest at index
+   * @throws ComponentRequestIndexError exception if idx is outside of allowable range
+   */
+  ComponentRequest at(size_t idx) const
+  {
+    if (idx >= header_()->num_requested_components) {
+      throw ComponentRequestIndexError(ERS_HERE, idx, header_()->num_requested_components - 1);
+    }
+
+    ComponentRequest component(GeoID::from_key(packed_components_()[idx]),
+                               shared_window_()->window_begin,
+                               shared_window_()->window_end);
+
+    // WindowExceptions are sorted by index
+    auto first = window_exceptions_();
+    auto last = first + shared_window_()->num_window_exceptions;
+    auto it = std::lower_bound(first, last, idx, [](const WindowException& e, size_t i) { return e.index < i; });
+    if (it != last && it->index == idx) {
+      component.window_begin = it->window_begin;
+      component.window_end = it->window_end;
+    }
+    return component;
+  }
+
+private:
+  /**
+   * @brief Get the size of a compact data array
+   * @param num_components Number of components
+   * @param num_window_exceptions Number of WindowExceptions
+   * @return Size of the data array in bytes
+   */
+  static size_t get_total_size_bytes_(size_t num_components, size_t num_window_exceptions)
+  {
+    return sizeof(TriggerRecordHeaderData) + sizeof(SharedWindow) + num_components * sizeof(uint64_t) + // NOLINT
+           num_window_exceptions * sizeof(WindowException);
+  }
+
+  /**
+   * @brief Get the TriggerRecordHeaderData from the m_data_arr array
+   * @return Pointer to the TriggerRecordHeaderData
+   */
+  TriggerRecordHeaderData* header_() const { return static_cast<TriggerRecordHeaderData*>(m_data_arr); }
+  /**
+   * @brief Get the SharedWindow from the m_data_arr array
+   * @return Pointer to the SharedWindow, which follows the TriggerRecordHeaderData
+   */
+  SharedWindow* shared_window_() const { return reinterpret_cast<SharedWindow*>(header_() + 1); } // NOLINT
+  /**
+   * @brief Get the packed GeoID array from the m_data_arr array
+   * @return Pointer to the first packed GeoID, which follows the SharedWindow
+   */
+  uint64_t* packed_components_() const // NOLINT(build/unsigned)
+  {
+    return reinterpret_cast<uint64_t*>(shared_window_() + 1); // NOLINT
+  }
+  /**
+   * @brief Get the WindowException array from the m_data_arr array
+   * @return Pointer to the first WindowException, which follows the packed GeoIDs
+   */
+  WindowException* window_exceptions_() const
+  {
+    return reinterpret_cast<WindowException*>(packed_components_() + header_()->num_requested_components); // NOLINT
+  }
+
+  void* m_data_arr{ nullptr }; ///< Flat memory containing the compact TriggerRecordHeader
+  bool m_alloc{ false };       ///< Whether the CompactTriggerRecordHeader owns the memory pointed by m_data_arr
+};
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_COMPACTTRIGGERRECORDHEADER_HPP_
@@ -9,11 +9,16 @@
 #ifndef DATAFORMATS_INCLUDE_DATAFORMATS_COMPONENTREQUEST_HPP_
 #define DATAFORMATS_INCLUDE_DATAFORMATS_COMPONENTREQUEST_HPP_
 
+#include "dataformats/FieldTable.hpp"
 #include "dataformats/GeoID.hpp"
+#include "dataformats/TextCodec.hpp"
 #include "dataformats/Types.hpp"
 
+#include <charconv>
+#include <istream>
 #include <ostream>
 #include <string>
+#include <tuple>
 
 namespace dunedaq {
 namespace dataformats {
@@ -80,6 +85,19 @@ operator>>(std::istream& is, ComponentRequest& cr)
   return is >> cr.component >> tmp >> tmp >> cr.window_begin >> tmp >> tmp >> cr.window_end;
 }
 
+/**
+ * @brief Fields of a ComponentRequest, in the order of its stream format
+ */
+template<>
+struct FieldTable<ComponentRequest>
+{
+  /// FieldDescriptors of the ComponentRequest fields
+  static constexpr auto fields =
+    std::make_tuple(DATAFORMATS_FIELD(ComponentRequest, component, "component", FieldFormat::kInline),
+                    DATAFORMATS_FIELD(ComponentRequest, window_begin, "begin"),
+                    DATAFORMATS_FIELD(ComponentRequest, window_end, "end"));
+};
+
 } // namespace dataformats
 } // namespace dunedaq
 
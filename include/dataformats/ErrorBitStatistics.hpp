@@ -0,0 +1,259 @@
+/**
+ * @file ErrorBitStatistics.hpp  Per-bit error counts over many Fragments and TriggerRecords
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_ERRORBITSTATISTICS_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_ERRORBITSTATISTICS_HPP_
+
+#include "dataformats/Fragment.hpp"
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/FragmentHeaderColumns.hpp"
+#include "dataformats/GeoID.hpp"
+#include "dataformats/GeoIDMap.hpp"
+#include "dataformats/TriggerRecord.hpp"
+#include "dataformats/TriggerRecordHeaderData.hpp"
+#include "dataformats/Types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Number of times each of the 32 error bits was set, out of a number of entries
+ */
+struct ErrorBitCounts
+{
+  /**
+   * @brief Number of error bits in a FragmentHeader or TriggerRecordHeaderData
+   */
+  static constexpr size_t s_num_bits = 32;
+
+  uint64_t entries{ 0 };                          ///< Number of error words added // NOLINT(build/unsigned)
+  uint64_t entries_with_errors{ 0 };              ///< Number of error words with any bit set // NOLINT(build/unsigned)
+  std::array<uint64_t, s_num_bits> bit_counts{}; ///< Number of error words with each bit set // NOLINT(build/unsigned)
+
+  /**
+   * @brief Count one error word
+   * @param error_bits Error word, e.g. FragmentHeader::error_bits
+   */
+  void add(uint32_t error_bits) noexcept // NOLINT(build/unsigned)
+  {
+    ++entries;
+    entries_with_errors += error_bits != 0;
+    // Error words are mostly zero, so visit only the bits that are set
+    while (error_bits != 0) {
+      ++bit_counts[__builtin_ctz(error_bits)];
+      error_bits &= error_bits - 1;
+    }
+  }
+
+  /**
+   * @brief Add the counts of another ErrorBitCounts to these
+   * @param other Counts to add
+   */
+  void merge(const ErrorBitCounts& other) noexcept
+  {
+    entries += other.entries;
+    entries_with_errors += other.entries_with_errors;
+    for (size_t bit = 0; bit < s_num_bits; ++bit) {
+      bit_counts[bit] += other.bit_counts[bit];
+    }
+  }
+
+  /**
+   * @brief Get the number of entries with a Fragment error bit set
+   * @param bit Bit to look up
+   * @return Number of entries with the bit set
+   */
+  uint64_t get_count(FragmentErrorBits bit) const noexcept // NOLINT(build/unsigned)
+  {
+    return bit_counts[static_cast<size_t>(bit)];
+  }
+  /**
+   * @brief Get the number of entries with a TriggerRecord error bit set
+   * @param bit Bit to look up
+   * @return Number of entries with the bit set
+   */
+  uint64_t get_count(TriggerRecordErrorBits bit) const noexcept // NOLINT(build/unsigned)
+  {
+    return bit_counts[static_cast<size_t>(bit)];
+  }
+
+  /**
+   * @brief Get the fraction of entries with a bit set
+   * @param bit Index of the bit
+   * @return Fraction of entries with the bit set, or 0 if there are no entries
+   */
+  double get_rate(size_t bit) const noexcept
+  {
+    return entries == 0 ? 0. : static_cast<double>(bit_counts[bit]) / static_cast<double>(entries);
+  }
+};
+
+/**
+ * @brief Accumulates error bit counts of Fragments and TriggerRecords, in total and grouped by FragmentType and
+ * by GeoID
+ *
+ * An ErrorBitStatistics is not thread-safe. For multi-threaded producers, give each thread its own instance and
+ * combine them with merge() when a histogram is published: the threads then never share memory while counting,
+ * and merging costs one pass over the groups rather than one per Fragment.
+ */
+class ErrorBitStatistics
+{
+public:
+  /**
+   * @brief Count the error bits of a Fragment
+   * @param fragment Fragment to count
+   */
+  void add(const Fragment& fragment)
+  {
+    add(*static_cast<const FragmentHeader*>(fragment.get_storage_location()));
+  }
+
+  /**
+   * @brief Count the error bits of a FragmentHeader
+   * @param header FragmentHeader to count
+   */
+  void add(const FragmentHeader& header)
+  {
+    add_fragment_(header.fragment_type, header.element_id, header.error_bits);
+  }
+
+  /**
+   * @brief Count the error bits of every row of a FragmentHeaderColumns
+   * @param columns Extracted FragmentHeaders to count
+   */
+  void add(const FragmentHeaderColumns& columns)
+  {
+    auto& fragment_type = columns.get<&FragmentHeader::fragment_type>();
+    auto& element_key = columns.get<&FragmentHeader::element_id>();
+    auto& error_bits = columns.get<&FragmentHeader::error_bits>();
+
+    // Rows come in runs of one FragmentType, and often of one GeoID, so the counts of the last type and GeoID
+    // are kept across rows and looked up again only when the key changes. The GeoIDMap entry is only held
+    // until the next insertion, which replaces it
+    ErrorBitCounts* type_counts = nullptr;
+    ErrorBitCounts* element_counts = nullptr;
+    fragment_type_t last_type = 0;
+    uint64_t last_key = 0; // NOLINT(build/unsigned)
+    for (size_t row = 0; row < columns.size(); ++row) {
+      if (type_counts == nullptr || fragment_type[row] != last_type) {
+        last_type = fragment_type[row];
+        type_counts = &m_counts_by_type[last_type];
+      }
+      if (element_counts == nullptr || element_key[row] != last_key) {
+        last_key = element_key[row];
+        element_counts = &m_counts_by_element[GeoID::from_key(last_key)];
+      }
+      m_fragment_counts.add(error_bits[row]);
+      type_counts->add(error_bits[row]);
+      element_counts->add(error_bits[row]);
+    }
+  }
+
+  /**
+   * @brief Count the error bits of a TriggerRecord and of all its Fragments
+   * @param record TriggerRecord to count
+   */
+  void add(const TriggerRecord& record)
+  {
+    m_record_counts.add(record.get_header_ref().get_header().error_bits);
+    for (auto& fragment : record.get_fragments_ref()) {
+      add(*fragment);
+    }
+  }
+
+  /**
+   * @brief Add the counts of another ErrorBitStatistics, e.g. one filled by another thread
+   * @param other Statistics to add
+   */
+  void merge(const ErrorBitStatistics& other)
+  {
+    m_record_counts.merge(other.m_record_counts);
+    m_fragment_counts.merge(other.m_fragment_counts);
+    for (auto& [type, counts] : other.m_counts_by_type) {
+      m_counts_by_type[type].merge(counts);
+    }
+    other.m_counts_by_element.for_each([&](const GeoID& id, const ErrorBitCounts& counts) {
+      m_counts_by_element[id].merge(counts);
+    });
+  }
+
+  /**
+   * @brief Reset all counts
+   */
+  void clear()
+  {
+    m_record_counts = ErrorBitCounts();
+    m_fragment_counts = ErrorBitCounts();
+    m_counts_by_type.clear();
+    m_counts_by_element.clear();
+  }
+
+  /**
+   * @brief Get the counts of the TriggerRecord error bits
+   * @return Counts over all TriggerRecords added
+   */
+  const ErrorBitCounts& get_record_counts() const noexcept { return m_record_counts; }
+  /**
+   * @brief Get the counts of the Fragment error bits
+   * @return Counts over all Fragments added
+   */
+  const ErrorBitCounts& get_fragment_counts() const noexcept { return m_fragment_counts; }
+  /**
+   * @brief Get the counts of the Fragment error bits for one FragmentType
+   * @param type FragmentType to look up
+   * @return Counts over the Fragments of that type, all zero if there were none
+   */
+  ErrorBitCounts get_counts(FragmentType type) const
+  {
+    auto it = m_counts_by_type.find(static_cast<fragment_type_t>(type));
+    return it == m_counts_by_type.end() ? ErrorBitCounts() : it->second;
+  }
+  /**
+   * @brief Get the counts of the Fragment error bits for one GeoID
+   * @param id GeoID to look up
+   * @return Counts over the Fragments from that GeoID, all zero if there were none
+   */
+  ErrorBitCounts get_counts(const GeoID& id) const
+  {
+    auto counts = m_counts_by_element.find(id);
+    return counts == nullptr ? ErrorBitCounts() : *counts;
+  }
+  /**
+   * @brief Get the counts of the Fragment error bits for every FragmentType seen
+   * @return Map from fragment type code to counts
+   */
+  const std::map<fragment_type_t, ErrorBitCounts>& get_counts_by_type() const noexcept { return m_counts_by_type; }
+  /**
+   * @brief Get the counts of the Fragment error bits for every GeoID seen
+   * @return Map from GeoID to counts
+   */
+  const GeoIDMap<ErrorBitCounts>& get_counts_by_element() const noexcept { return m_counts_by_element; }
+
+private:
+  void add_fragment_(fragment_type_t type, const GeoID& id, uint32_t error_bits) // NOLINT(build/unsigned)
+  {
+    m_fragment_counts.add(error_bits);
+    m_counts_by_type[type].add(error_bits);
+    m_counts_by_element[id].add(error_bits);
+  }
+
+  ErrorBitCounts m_record_counts;                             ///< Counts of the TriggerRecord error bits
+  ErrorBitCounts m_fragment_counts;                           ///< Counts of the Fragment error bits
+  std::map<fragment_type_t, ErrorBitCounts> m_counts_by_type; ///< Fragment counts per fragment type code
+  GeoIDMap<ErrorBitCounts> m_counts_by_element;               ///< Fragment counts per GeoID
+};
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_ERRORBITSTATISTICS_HPP_
@@ -0,0 +1,167 @@
+/**
+ * @file FieldTable.hpp  Compile-time field descriptors for the dataformats header structs
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_FIELDTABLE_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_FIELDTABLE_HPP_
+
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief How a field is written by the text codecs
+ */
+enum class FieldFormat
+{
+  kDecimal, ///< Written in base 10
+  kHex,     ///< Written in base 16, without prefix
+  kInline   ///< Written without its name, e.g. a struct whose own fields are named
+};
+
+/**
+ * @brief Describes one field of a struct: its name, its location and its type
+ * @tparam Struct Struct the field belongs to
+ * @tparam T Type of the field
+ */
+template<typename Struct, typename T>
+struct FieldDescriptor
+{
+  using struct_type = Struct; ///< Struct the field belongs to
+  using value_type = T;       ///< Type of the field
+
+  std::string_view name; ///< Name of the field, as used by the stream operators
+  T Struct::*member;     ///< Pointer to the field
+  size_t offset;         ///< Byte offset of the field within the struct, as given by offsetof
+  FieldFormat format;    ///< How text codecs write the field
+
+  /**
+   * @brief Access the field in an instance of the struct
+   * @param object Struct instance
+   * @return Reference to the field
+   */
+  constexpr const T& get(const Struct& object) const noexcept { return object.*member; }
+  /**
+   * @brief Access the field in an instance of the struct
+   * @param object Struct instance
+   * @return Reference to the field
+   */
+  constexpr T& get(Struct& object) const noexcept { return object.*member; }
+};
+
+/**
+ * @brief Create a FieldDescriptor, deducing the struct and field types from the member pointer
+ *
+ * Use DATAFORMATS_FIELD rather than calling this directly, so that the member and its offset cannot disagree.
+ *
+ * @param member Pointer to the field
+ * @param offset Byte offset of the field, offsetof(Struct, field)
+ * @param name Name of the field
+ * @param format How text codecs write the field
+ * @return FieldDescriptor of the field
+ */
+template<typename Struct, typename T>
+constexpr FieldDescriptor<Struct, T>
+make_field(T Struct::*member, size_t offset, std::string_view name, FieldFormat format = FieldFormat::kDecimal)
+{
+  return { name, member, offset, format };
+}
+
+/**
+ * @brief Create the FieldDescriptor of Struct::member, with its name and optionally its FieldFormat
+ */
+#define DATAFORMATS_FIELD(Struct, member, ...) /* NOLINT */                                                        \
+  ::dunedaq::dataformats::make_field(&Struct::member, offsetof(Struct, member), __VA_ARGS__)
+
+/**
+ * @brief Table of the fields of a struct, in the order of its stream format
+ *
+ * Specializations provide a static constexpr tuple of FieldDescriptors named fields. Codecs iterate over it
+ * with for_each_field(), so adding a field to the table updates every codec at once.
+ */
+template<typename T>
+struct FieldTable;
+
+/**
+ * @brief Whether a type has a FieldTable specialization
+ */
+template<typename T, typename = void>
+struct has_field_table : std::false_type
+{};
+/// @cond Specialization is documented by the primary template
+template<typename T>
+struct has_field_table<T, std::void_t<decltype(FieldTable<T>::fields)>> : std::true_type
+{};
+/// @endcond
+/**
+ * @brief Whether a type has a FieldTable specialization
+ */
+template<typename T>
+constexpr bool has_field_table_v = has_field_table<T>::value;
+
+/**
+ * @brief Number of fields in the FieldTable of a struct
+ */
+template<typename T>
+constexpr size_t num_fields_v = std::tuple_size_v<std::decay_t<decltype(FieldTable<T>::fields)>>;
+
+/**
+ * @brief Check that the fields of a FieldTable lie within their struct and do not overlap
+ * @tparam T Struct with a FieldTable
+ * @return Whether the field offsets are consistent with the field sizes
+ */
+template<typename T>
+constexpr bool
+are_field_offsets_consistent()
+{
+  constexpr size_t num_fields = num_fields_v<T>;
+  size_t begins[num_fields] = {};
+  size_t ends[num_fields] = {};
+  size_t index = 0;
+  std::apply(
+    [&](const auto&... fields) {
+      ((begins[index] = fields.offset,
+        ends[index] = fields.offset + sizeof(typename std::decay_t<decltype(fields)>::value_type),
+        ++index),
+       ...);
+    },
+    FieldTable<T>::fields);
+  for (size_t i = 0; i < num_fields; ++i) {
+    if (ends[i] > sizeof(T)) {
+      return false;
+    }
+    for (size_t j = 0; j < i; ++j) {
+      if (begins[i] < ends[j] && begins[j] < ends[i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Call a function for each FieldDescriptor of a struct, in table order
+ * @tparam T Struct with a FieldTable
+ * @param func Function called as func(descriptor) for each field
+ */
+template<typename T, typename Func>
+constexpr void
+for_each_field(Func&& func)
+{
+  static_assert(are_field_offsets_consistent<T>(), "FieldTable offsets must match the struct layout");
+  std::apply([&](const auto&... fields) { (func(fields), ...); }, FieldTable<T>::fields);
+}
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_FIELDTABLE_HPP_
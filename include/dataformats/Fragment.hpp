@@ -16,14 +16,15 @@
 #include "dataformats/FragmentHeader.hpp"
 #include "dataformats/GeoID.hpp"
 #include "dataformats/Types.hpp"
+#include "dataformats/detail/AtomicBits.hpp"
 
 #include "ers/Issue.hpp"
 
+#include <algorithm>
 #include <bitset>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
-#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -71,46 +72,29 @@ public:
     kCopyFromBuffer  ///< Copy the contents of the buffer into a new Fragment array
   };
 
+  /**
+   * @brief Fragments up to this size (including the FragmentHeader) are stored inside the Fragment object itself
+   *
+   * Larger Fragments are stored in a heap-allocated data array. The data array of an inline Fragment is part of the
+   * object, so pointers into it do not survive a move; see Fragment(Fragment&&)
+   */
+  static constexpr size_t s_inline_storage_size = 256;
+
   /**
    * @brief Fragment constructor using a vector of buffer pointers
    * @param pieces Vector of pairs of pointer/size pairs used to initialize Fragment payload
    */
-  explicit Fragment(const std::vector<std::pair<void*, size_t>>& pieces)
-  {
-    size_t size = sizeof(FragmentHeader) +
-                  std::accumulate(pieces.begin(), pieces.end(), 0ULL, [](auto& a, auto& b) { return a + b.second; });
-
-    if (size < sizeof(FragmentHeader)) {
-      throw FragmentSizeError(ERS_HERE, size, sizeof(FragmentHeader), -1);
-    }
-
-    m_data_arr = malloc(size); // NOLINT(build/unsigned)
-    if (m_data_arr == nullptr) {
-      throw MemoryAllocationFailed(ERS_HERE, size);
-    }
-    m_alloc = true;
-
-    FragmentHeader header;
-    header.size = size;
-    memcpy(m_data_arr, &header, sizeof(header));
-
-    size_t offset = sizeof(FragmentHeader);
-    for (auto& piece : pieces) {
-      if (piece.first == nullptr) {
-        throw FragmentBufferError(ERS_HERE, piece.first, piece.second);
-      }
-      memcpy(static_cast<uint8_t*>(m_data_arr) + offset, piece.first, piece.second); // NOLINT(build/unsigned)
-      offset += piece.second;
-    }
-  }
+  explicit Fragment(const std::vector<std::pair<void*, size_t>>& pieces) { init_(pieces.data(), pieces.size()); }
   /**
    * @brief Fragment constructor using a buffer and size
    * @param buffer Pointer to Fragment payload
    * @param size Size of payload
    */
   Fragment(void* buffer, size_t size)
-    : Fragment({ std::make_pair(buffer, size) })
-  {}
+  {
+    const std::pair<void*, size_t> piece(buffer, size);
+    init_(&piece, 1);
+  }
   /**
    * @brief Framgnet constructor using existing Fragment array
    * @param existing_fragment_buffer Pointer to existing Fragment array
@@ -125,19 +109,62 @@ public:
       m_alloc = true;
     } else if (adoption_mode == BufferAdoptionMode::kCopyFromBuffer) {
       auto header = reinterpret_cast<FragmentHeader*>(existing_fragment_buffer); // NOLINT
-      m_data_arr = malloc(header->size);
-      if (m_data_arr == nullptr) {
-        throw MemoryAllocationFailed(ERS_HERE, header->size);
-      }
-      m_alloc = true;
+      allocate_(header->size);
       memcpy(m_data_arr, existing_fragment_buffer, header->size);
     }
   }
 
+  /**
+   * @brief Create a Fragment without payload, e.g. to report that the requested data could not be found
+   * @param header Header fields to copy into the Fragment (the size field is *not* copied)
+   * @param error_bit Error bit to set in addition to those already set in header
+   * @return Header-only Fragment, which never requires a heap allocation
+   */
+  static Fragment create_empty(const FragmentHeader& header,
+                               FragmentErrorBits error_bit = FragmentErrorBits::kDataNotFound)
+  {
+    Fragment frag;
+    frag.m_data_arr = frag.m_inline_storage;
+    FragmentHeader empty_header;
+    empty_header.size = sizeof(FragmentHeader);
+    memcpy(frag.m_data_arr, &empty_header, sizeof(empty_header));
+    frag.set_header_fields(header);
+    frag.set_error_bit(error_bit, true);
+    return frag;
+  }
+
   Fragment(Fragment const&) = delete;            ///< Fragment copy constructor is deleted
-  Fragment(Fragment&&) = default;                ///< Default Fragment move constructor
   Fragment& operator=(Fragment const&) = delete; ///< Fragment copy assignment operator is deleted
-  Fragment& operator=(Fragment&&) = default;     ///< Default move assignment operator
+
+  /**
+   * @brief Fragment move constructor
+   *
+   * A heap-allocated or adopted data array is handed over, so pointers obtained from other (get_storage_location(),
+   * get_data()) stay valid and now refer to this Fragment. An inline Fragment, no larger than
+   * s_inline_storage_size, is copied into this object instead: pointers obtained from other are invalidated, and
+   * must be obtained again from this Fragment.
+   *
+   * @param other Fragment to move from. It no longer refers to any data array afterwards
+   */
+  Fragment(Fragment&& other) noexcept { take_(other); }
+  /**
+   * @brief Fragment move assignment operator
+   *
+   * Pointers obtained from other stay valid only if its data array is not inline, as for the move constructor.
+   * Pointers obtained from this Fragment before the assignment are always invalidated.
+   *
+   * @param other Fragment to move from. It no longer refers to any data array afterwards
+   * @return Reference to this Fragment
+   */
+  Fragment& operator=(Fragment&& other) noexcept
+  {
+    if (&other != this) {
+      if (m_alloc)
+        free(m_data_arr);
+      take_(other);
+    }
+    return *this;
+  }
 
   /**
    * @brief Fragment destructor
@@ -270,6 +297,46 @@ public:
     set_error_bits(bits);
   }
 
+  /**
+   * @brief Get the error_bits header field with an atomic load, for use while other threads update it
+   * @return Bitset generated from the header's error_bits field
+   */
+  std::bitset<32> atomic_get_error_bits() const { return detail::atomic_load_bits(&header_()->error_bits); }
+  /**
+   * @brief Set the designated error bit with an atomic read-modify-write
+   *
+   * Unlike set_error_bit(), concurrent calls from several threads on the same buffer never lose each other's
+   * updates. Plain reads and writes of error_bits must not run concurrently with this.
+   *
+   * @param bit Bit to set
+   * @param value Value (true/false) for the error bit
+   */
+  void atomic_set_error_bit(FragmentErrorBits bit, bool value)
+  {
+    detail::atomic_assign_bit(&header_()->error_bits, static_cast<size_t>(bit), value);
+  }
+  /**
+   * @brief Atomically set the designated error bit and report whether it was already set
+   *
+   * Exactly one of several threads racing to set the same bit gets false, e.g. to decide which one reports it.
+   *
+   * @param bit Bit to set
+   * @return Value of the bit before it was set
+   */
+  bool atomic_test_and_set_error_bit(FragmentErrorBits bit)
+  {
+    return detail::atomic_assign_bit(&header_()->error_bits, static_cast<size_t>(bit), true);
+  }
+  /**
+   * @brief Atomically clear the designated error bit and report whether it was set
+   * @param bit Bit to clear
+   * @return Value of the bit before it was cleared
+   */
+  bool atomic_test_and_clear_error_bit(FragmentErrorBits bit)
+  {
+    return detail::atomic_assign_bit(&header_()->error_bits, static_cast<size_t>(bit), false);
+  }
+
   /**
    * @brief Get the fragment_type_t value stored in the header
    * @return Current value of the fragment_type header field
@@ -318,8 +385,81 @@ private:
    * @return Pointer to the FragmentHeader
    */
   FragmentHeader* header_() const { return static_cast<FragmentHeader*>(m_data_arr); }
+
+  Fragment() = default; ///< Used by create_empty, leaves the Fragment without a data array
+
+  /**
+   * @brief Set up the data array from a list of payload pieces
+   * @param pieces Pointer to the first pointer/size pair
+   * @param num_pieces Number of pointer/size pairs
+   */
+  void init_(const std::pair<void*, size_t>* pieces, size_t num_pieces)
+  {
+    size_t size = sizeof(FragmentHeader);
+    for (size_t i = 0; i < num_pieces; ++i) {
+      size += pieces[i].second;
+    }
+
+    if (size < sizeof(FragmentHeader)) {
+      throw FragmentSizeError(ERS_HERE, size, sizeof(FragmentHeader), -1);
+    }
+
+    allocate_(size);
+
+    FragmentHeader header;
+    header.size = size;
+    memcpy(m_data_arr, &header, sizeof(header));
+
+    size_t offset = sizeof(FragmentHeader);
+    for (size_t i = 0; i < num_pieces; ++i) {
+      if (pieces[i].first == nullptr) {
+        if (m_alloc)
+          free(m_data_arr);
+        throw FragmentBufferError(ERS_HERE, pieces[i].first, pieces[i].second);
+      }
+      memcpy(static_cast<uint8_t*>(m_data_arr) + offset, pieces[i].first, pieces[i].second); // NOLINT(build/unsigned)
+      offset += pieces[i].second;
+    }
+  }
+  /**
+   * @brief Point m_data_arr at memory for a Fragment of the given size, using the inline storage if it fits
+   * @param size Total size of the Fragment, including the FragmentHeader
+   */
+  void allocate_(size_t size)
+  {
+    if (size <= s_inline_storage_size) {
+      m_data_arr = m_inline_storage;
+      return;
+    }
+    m_data_arr = malloc(size); // NOLINT(build/unsigned)
+    if (m_data_arr == nullptr) {
+      throw MemoryAllocationFailed(ERS_HERE, size);
+    }
+    m_alloc = true;
+  }
+  /**
+   * @brief Take over the data array of another Fragment, leaving it empty
+   * @param other Fragment to take the data array from
+   *
+   * Inline data has to be copied, everything else is handed over by pointer
+   */
+  void take_(Fragment& other) noexcept
+  {
+    if (other.m_data_arr == other.m_inline_storage) {
+      memcpy(m_inline_storage, other.m_inline_storage, std::min<size_t>(other.get_size(), s_inline_storage_size));
+      m_data_arr = m_inline_storage;
+      m_alloc = false;
+      other.m_data_arr = nullptr;
+    } else {
+      m_data_arr = std::exchange(other.m_data_arr, nullptr);
+      m_alloc = std::exchange(other.m_alloc, false);
+    }
+  }
+
   void* m_data_arr{ nullptr }; ///< Flat memory containing a FragmentHeader and the data payload
-  bool m_alloc{ false };       ///< Whether the Fragment owns the memory pointed by m_data_arr
+  bool m_alloc{ false };       ///< Whether the Fragment owns the heap memory pointed by m_data_arr
+  /// Storage for Fragments no larger than s_inline_storage_size, used instead of a heap allocation
+  alignas(FragmentHeader) uint8_t m_inline_storage[s_inline_storage_size]; // NOLINT
 };
 
 } // namespace dataformats
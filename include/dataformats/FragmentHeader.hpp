@@ -9,16 +9,21 @@
 #ifndef DATAFORMATS_INCLUDE_DATAFORMATS_FRAGMENTHEADER_HPP_
 #define DATAFORMATS_INCLUDE_DATAFORMATS_FRAGMENTHEADER_HPP_
 
+#include "dataformats/FieldTable.hpp"
 #include "dataformats/GeoID.hpp"
+#include "dataformats/TextCodec.hpp"
 #include "dataformats/Types.hpp"
 
 #include "logging/Logging.hpp"
 
 #include <bitset>
+#include <charconv>
 #include <cstdlib>
 #include <map>
 #include <numeric>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace dunedaq {
@@ -176,21 +181,62 @@ enum class FragmentType : fragment_type_t
                                                    ///< get_fragment_type_names
 };
 
+/**
+ * @brief Name of a FragmentType, without allocating
+ * @param type Type to name
+ * @return Name of the given type, or an empty view if the type is not known
+ *
+ * These names can be used, for example, as HDF5 Group names
+ */
+constexpr std::string_view
+fragment_type_to_string_view(FragmentType type)
+{
+  switch (type) {
+    case FragmentType::kFakeData:
+      return "FakeData";
+    case FragmentType::kTPCData:
+      return "TPC";
+    case FragmentType::kPDSData:
+      return "PDS";
+    case FragmentType::kNDLArTPC:
+      return "NDLArTPC";
+    case FragmentType::kTriggerPrimitives:
+      return "TriggerPrimitives";
+    case FragmentType::kTriggerActivities:
+      return "TriggerActivities";
+    case FragmentType::kTriggerCandidates:
+      return "TriggerCandidates";
+    case FragmentType::kUnknown:
+      break;
+  }
+  return {};
+}
+
+/**
+ * @brief The FragmentType values that have names, in enumeration order
+ */
+constexpr FragmentType s_named_fragment_types[] = { FragmentType::kFakeData,          FragmentType::kTPCData,
+                                                    FragmentType::kPDSData,           FragmentType::kNDLArTPC,
+                                                    FragmentType::kTriggerPrimitives, FragmentType::kTriggerActivities,
+                                                    FragmentType::kTriggerCandidates };
+
 /**
  * @brief This map relates FragmentType values to string names
+ * @return Reference to a map built once from fragment_type_to_string_view
  *
  * These names can be used, for example, as HDF5 Group names
  */
-inline std::map<FragmentType, std::string>
+inline const std::map<FragmentType, std::string>&
 get_fragment_type_names()
 {
-  return { { FragmentType::kFakeData, "FakeData" },
-           { FragmentType::kTPCData, "TPC" },
-           { FragmentType::kPDSData, "PDS" },
-           { FragmentType::kNDLArTPC, "NDLArTPC" },
-           { FragmentType::kTriggerPrimitives, "TriggerPrimitives" },
-           { FragmentType::kTriggerActivities, "TriggerActivities" },
-           { FragmentType::kTriggerCandidates, "TriggerCandidates" } };
+  static const std::map<FragmentType, std::string> names = [] {
+    std::map<FragmentType, std::string> result;
+    for (auto type : s_named_fragment_types) {
+      result.emplace(type, fragment_type_to_string_view(type));
+    }
+    return result;
+  }();
+  return names;
 }
 
 /**
@@ -201,11 +247,12 @@ get_fragment_type_names()
 inline std::string
 fragment_type_to_string(FragmentType type)
 {
-  if (!get_fragment_type_names().count(type)) {
+  auto name = fragment_type_to_string_view(type);
+  if (name.empty()) {
     ers::error(FragmentTypeConversionError(ERS_HERE, std::to_string(static_cast<int>(type))));
     return "UNKNOWN";
   }
-  return get_fragment_type_names().at(type);
+  return std::string(name);
 }
 
 /**
@@ -214,13 +261,13 @@ fragment_type_to_string(FragmentType type)
  * @return FragmentType corresponding to given string
  */
 inline FragmentType
-string_to_fragment_type(std::string name)
+string_to_fragment_type(std::string_view name)
 {
-  for (auto& it : get_fragment_type_names()) {
-    if (it.second == name)
-      return it.first;
+  for (auto type : s_named_fragment_types) {
+    if (fragment_type_to_string_view(type) == name)
+      return type;
   }
-  ers::error(FragmentTypeConversionError(ERS_HERE, name));
+  ers::error(FragmentTypeConversionError(ERS_HERE, std::string(name)));
   return FragmentType::kUnknown;
 }
 
@@ -263,6 +310,29 @@ operator>>(std::istream& o, FragmentHeader& hdr)
          hdr.element_id >> tmp >> tmp >> hdr.error_bits >> tmp >> tmp >> hdr.fragment_type >> tmp >> tmp >>
          hdr.sequence_number;
 }
+
+/**
+ * @brief Fields of a FragmentHeader, in the order of its stream format
+ */
+template<>
+struct FieldTable<FragmentHeader>
+{
+  /// FieldDescriptors of the FragmentHeader fields
+  static constexpr auto fields =
+    std::make_tuple(DATAFORMATS_FIELD(FragmentHeader, fragment_header_marker, "check_word", FieldFormat::kHex),
+                    DATAFORMATS_FIELD(FragmentHeader, version, "version"),
+                    DATAFORMATS_FIELD(FragmentHeader, size, "size"),
+                    DATAFORMATS_FIELD(FragmentHeader, trigger_number, "trigger_number"),
+                    DATAFORMATS_FIELD(FragmentHeader, run_number, "run_number"),
+                    DATAFORMATS_FIELD(FragmentHeader, trigger_timestamp, "trigger_timestamp"),
+                    DATAFORMATS_FIELD(FragmentHeader, window_begin, "window_begin"),
+                    DATAFORMATS_FIELD(FragmentHeader, window_end, "window_end"),
+                    DATAFORMATS_FIELD(FragmentHeader, element_id, "element_id"),
+                    DATAFORMATS_FIELD(FragmentHeader, error_bits, "error_bits"),
+                    DATAFORMATS_FIELD(FragmentHeader, fragment_type, "fragment_type"),
+                    DATAFORMATS_FIELD(FragmentHeader, sequence_number, "sequence_number"));
+};
+
 } // namespace dataformats
 } // namespace dunedaq
 
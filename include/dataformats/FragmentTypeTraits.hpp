@@ -0,0 +1,185 @@
+/**
+ * @file FragmentTypeTraits.hpp  Compile-time properties of each FragmentType
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_FRAGMENTTYPETRAITS_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_FRAGMENTTYPETRAITS_HPP_
+
+#include "dataformats/Fragment.hpp"
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/GeoID.hpp"
+#include "dataformats/Types.hpp"
+#include "dataformats/daphne/DAPHNEFrame.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Properties shared by all FragmentTypes
+ * @tparam Type FragmentType described
+ * @tparam System GeoID::SystemType of the components producing this FragmentType
+ */
+template<FragmentType Type, GeoID::SystemType System>
+struct FragmentTypeTraitsBase
+{
+  static constexpr FragmentType fragment_type = Type;                          ///< The FragmentType
+  static constexpr std::string_view name = fragment_type_to_string_view(Type); ///< Name of the FragmentType
+  static constexpr GeoID::SystemType system_type = System; ///< System of the components producing this type
+};
+
+/**
+ * @brief Properties of a FragmentType whose payload is a packed array of fixed-size frames
+ *
+ * Can also be used directly when the frame struct is known from elsewhere than the FragmentType, e.g.
+ * FrameFragmentTypeTraits<FragmentType::kTPCData, GeoID::SystemType::kTPC, WIB2Frame>.
+ *
+ * @tparam Type FragmentType described
+ * @tparam System GeoID::SystemType of the components producing this FragmentType
+ * @tparam Frame Frame struct overlaying each frame of the payload
+ */
+template<FragmentType Type, GeoID::SystemType System, typename Frame>
+struct FrameFragmentTypeTraits : FragmentTypeTraitsBase<Type, System>
+{
+  using frame_type = Frame;                                 ///< Frame struct of the payload
+  static constexpr size_t frame_size = sizeof(frame_type); ///< Size of one frame, in bytes
+
+  /**
+   * @brief Get the frames in the payload of a Fragment
+   * @param fragment Fragment of this type
+   * @return Pointer to the first frame
+   */
+  static const frame_type* get_frames(const Fragment& fragment)
+  {
+    return static_cast<const frame_type*>(fragment.get_data()); // NOLINT
+  }
+  /**
+   * @brief Get the number of complete frames in the payload of a Fragment
+   * @param fragment Fragment of this type
+   * @return Number of frames
+   */
+  static size_t get_num_frames(const Fragment& fragment)
+  {
+    return (fragment.get_size() - sizeof(FragmentHeader)) / frame_size;
+  }
+  /**
+   * @brief Get the timestamp of a frame
+   * @param frame Frame to read
+   * @return Timestamp of the frame
+   */
+  static timestamp_t get_timestamp(const frame_type& frame) { return frame.get_timestamp(); }
+};
+
+/**
+ * @brief Properties of a FragmentType whose payload has no fixed frame structure
+ * @tparam Type FragmentType described
+ * @tparam System GeoID::SystemType of the components producing this FragmentType
+ */
+template<FragmentType Type, GeoID::SystemType System>
+struct OpaqueFragmentTypeTraits : FragmentTypeTraitsBase<Type, System>
+{
+  using frame_type = void;              ///< There is no frame struct for this type
+  static constexpr size_t frame_size = 0; ///< There is no fixed frame size for this type
+};
+
+/**
+ * @brief Compile-time properties of a FragmentType
+ *
+ * Every specialization provides fragment_type, name, system_type, frame_type and frame_size. Those whose
+ * frame_type is not void also provide get_frames(), get_num_frames() and get_timestamp().
+ */
+template<FragmentType Type>
+struct FragmentTypeTraits : OpaqueFragmentTypeTraits<Type, GeoID::SystemType::kInvalid>
+{};
+
+/// @cond Specializations are documented by the primary template
+// TPC payloads are WIBFrames or WIB2Frames, of different sizes, and the FragmentType does not say which
+template<>
+struct FragmentTypeTraits<FragmentType::kTPCData>
+  : OpaqueFragmentTypeTraits<FragmentType::kTPCData, GeoID::SystemType::kTPC>
+{};
+template<>
+struct FragmentTypeTraits<FragmentType::kPDSData>
+  : FrameFragmentTypeTraits<FragmentType::kPDSData, GeoID::SystemType::kPDS, DAPHNEFrame>
+{};
+// PACMAN messages have a variable number of words, and PACMANFrame only provides accessors into them
+template<>
+struct FragmentTypeTraits<FragmentType::kNDLArTPC>
+  : OpaqueFragmentTypeTraits<FragmentType::kNDLArTPC, GeoID::SystemType::kNDLArTPC>
+{};
+template<>
+struct FragmentTypeTraits<FragmentType::kTriggerPrimitives>
+  : OpaqueFragmentTypeTraits<FragmentType::kTriggerPrimitives, GeoID::SystemType::kDataSelection>
+{};
+template<>
+struct FragmentTypeTraits<FragmentType::kTriggerActivities>
+  : OpaqueFragmentTypeTraits<FragmentType::kTriggerActivities, GeoID::SystemType::kDataSelection>
+{};
+template<>
+struct FragmentTypeTraits<FragmentType::kTriggerCandidates>
+  : OpaqueFragmentTypeTraits<FragmentType::kTriggerCandidates, GeoID::SystemType::kDataSelection>
+{};
+/// @endcond
+
+/**
+ * @brief Whether the payload of a FragmentType is an array of fixed-size frames
+ */
+template<FragmentType Type>
+constexpr bool has_frames_v = !std::is_void_v<typename FragmentTypeTraits<Type>::frame_type>;
+
+/**
+ * @brief Call a visitor with the FragmentTypeTraits of a FragmentType known only at run time
+ * @param type FragmentType to dispatch on
+ * @param visitor Callable invoked as visitor(FragmentTypeTraits<T>()), which must return the same type for every T.
+ * Types that are not known are dispatched as FragmentType::kUnknown
+ * @return The value returned by the visitor
+ */
+template<typename Visitor>
+decltype(auto)
+visit_fragment_type(FragmentType type, Visitor&& visitor)
+{
+  switch (type) {
+    case FragmentType::kFakeData:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kFakeData>());
+    case FragmentType::kTPCData:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kTPCData>());
+    case FragmentType::kPDSData:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kPDSData>());
+    case FragmentType::kNDLArTPC:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kNDLArTPC>());
+    case FragmentType::kTriggerPrimitives:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kTriggerPrimitives>());
+    case FragmentType::kTriggerActivities:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kTriggerActivities>());
+    case FragmentType::kTriggerCandidates:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kTriggerCandidates>());
+    default:
+      return std::forward<Visitor>(visitor)(FragmentTypeTraits<FragmentType::kUnknown>());
+  }
+}
+
+/**
+ * @brief Call a visitor with the FragmentTypeTraits of a Fragment's type
+ * @param fragment Fragment whose type to dispatch on
+ * @param visitor Callable invoked as visitor(FragmentTypeTraits<T>()), see visit_fragment_type(FragmentType, Visitor)
+ * @return The value returned by the visitor
+ */
+template<typename Visitor>
+decltype(auto)
+visit_fragment_type(const Fragment& fragment, Visitor&& visitor)
+{
+  return visit_fragment_type(fragment.get_fragment_type(), std::forward<Visitor>(visitor));
+}
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_FRAGMENTTYPETRAITS_HPP_
@@ -0,0 +1,150 @@
+/**
+ * @file FrameTranspose.hpp Conversion of WIB and WIB2 frames to channel-major ADC arrays
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_FRAMETRANSPOSE_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_FRAMETRANSPOSE_HPP_
+
+#include "dataformats/wib/WIBFrame.hpp"
+#include "dataformats/wib2/WIB2Frame.hpp"
+
+#include "ers/Issue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dunedaq {
+
+/**
+ * @brief An ERS Error indicating that a channel range does not fit in a frame
+ * @param ftcr_first_channel First channel of the range
+ * @param ftcr_num_channels Number of channels in the range
+ * @param ftcr_frame_channels Number of channels in the frame
+ * @cond Doxygen doesn't like ERS macros LCOV_EXCL_START
+ */
+ERS_DECLARE_ISSUE(dataformats,
+                  FrameTransposeChannelRangeError,
+                  "Channels " << ftcr_first_channel << " to " << ftcr_first_channel + ftcr_num_channels - 1
+                              << " are not all within the " << ftcr_frame_channels << " channels of a frame",
+                  ((int)ftcr_first_channel)((int)ftcr_num_channels)((int)ftcr_frame_channels)) // NOLINT
+                                                                                                /// @endcond LCOV_EXCL_STOP
+
+/**
+ * @brief An ERS Error indicating that the rows of a channel-major array are too short for the frames
+ * @param ftrs_row_stride Distance between the rows, in values
+ * @param ftrs_num_frames Number of frames, i.e. values per row
+ * @cond Doxygen doesn't like ERS macros LCOV_EXCL_START
+ */
+ERS_DECLARE_ISSUE(dataformats,
+                  FrameTransposeRowStrideError,
+                  "A row stride of " << ftrs_row_stride << " cannot hold " << ftrs_num_frames << " frames",
+                  ((size_t)ftrs_row_stride)((size_t)ftrs_num_frames)) // NOLINT
+                                                                      /// @endcond LCOV_EXCL_STOP
+
+namespace dataformats {
+
+/**
+ * @brief Row alignment, in values, that keeps every row of a channel-major array on a 64-byte cache line boundary
+ */
+constexpr size_t s_channel_major_row_alignment = 32;
+
+/**
+ * @brief Get a row stride for a channel-major array that keeps rows cache line aligned
+ * @param num_frames Number of frames, i.e. values per row
+ * @return num_frames rounded up to a multiple of s_channel_major_row_alignment
+ */
+constexpr size_t
+get_channel_major_row_stride(size_t num_frames) noexcept
+{
+  return (num_frames + s_channel_major_row_alignment - 1) / s_channel_major_row_alignment *
+         s_channel_major_row_alignment;
+}
+
+/**
+ * @brief Write the ADC values of consecutive WIBFrames as a channel-major array
+ *
+ * Value adcs[(ch - first_channel) * row_stride + i] is frames[i].get_channel(ch). Rows are written from index 0 to
+ * num_frames - 1; any padding up to row_stride is left untouched. Frames are decoded in tiles of a few ticks,
+ * which are then transposed in 8x8 blocks, so that both the frames and the rows are accessed sequentially.
+ *
+ * Different channel ranges write different rows, so callers can split the channels of a large batch between
+ * threads, each calling this with its own range.
+ *
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param adcs Output array, with num_channels rows of row_stride values. A 64-byte aligned array with a row stride
+ * from get_channel_major_row_stride() gives aligned rows
+ * @param row_stride Distance between rows, in values; at least num_frames
+ * @param first_channel First channel to write
+ * @param num_channels Number of channels to write
+ * @throws FrameTransposeChannelRangeError if the channel range is not within a frame
+ * @throws FrameTransposeRowStrideError if row_stride is less than num_frames
+ */
+void
+transpose_to_channel_major(const WIBFrame* frames,
+                           size_t num_frames,
+                           uint16_t* adcs, // NOLINT(build/unsigned)
+                           size_t row_stride,
+                           int first_channel = 0,
+                           int num_channels = WIBFrame::s_num_ch_per_frame);
+
+/**
+ * @brief Write the ADC values of consecutive WIB2Frames as a channel-major array
+ *
+ * Value adcs[(ch - first_channel) * row_stride + i] is frames[i].get_adc(ch); otherwise as for WIBFrames.
+ *
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param adcs Output array, with num_channels rows of row_stride values
+ * @param row_stride Distance between rows, in values; at least num_frames
+ * @param first_channel First channel to write
+ * @param num_channels Number of channels to write
+ * @throws FrameTransposeChannelRangeError if the channel range is not within a frame
+ * @throws FrameTransposeRowStrideError if row_stride is less than num_frames
+ */
+void
+transpose_to_channel_major(const WIB2Frame* frames,
+                           size_t num_frames,
+                           uint16_t* adcs, // NOLINT(build/unsigned)
+                           size_t row_stride,
+                           int first_channel = 0,
+                           int num_channels = WIB2Frame::s_num_channels);
+
+/**
+ * @brief Write the pedestal-subtracted ADC values of consecutive WIB2Frames as one channel-major array per plane
+ *
+ * Decoding, pedestal subtraction, plane splitting and transposition happen in one pass over cache-sized tiles.
+ * Each plane array holds the channels of both FEMBs, FEMB 0 first:
+ *
+ * - u_adcs[(femb * 40 + i) * row_stride + t] is frames[t].get_u(femb, i) - pedestals[femb * 128 + i]
+ * - v_adcs[(femb * 40 + i) * row_stride + t] is frames[t].get_v(femb, i) - pedestals[femb * 128 + 40 + i]
+ * - x_adcs[(femb * 48 + i) * row_stride + t] is frames[t].get_x(femb, i) - pedestals[femb * 128 + 80 + i]
+ *
+ * Differences are computed modulo 2^16, so they are exact whenever they fit in an int16_t, e.g. for pedestals
+ * from 0 to 16383. Padding up to row_stride is left untouched.
+ *
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param pedestals WIB2Frame::s_num_channels pedestals, in the order of WIB2Frame::get_adc()
+ * @param u_adcs Output array for the U planes, with 2 * WIB2Frame::s_u_channels_per_femb rows of row_stride values
+ * @param v_adcs Output array for the V planes, with 2 * WIB2Frame::s_v_channels_per_femb rows of row_stride values
+ * @param x_adcs Output array for the X planes, with 2 * WIB2Frame::s_x_channels_per_femb rows of row_stride values
+ * @param row_stride Distance between rows, in values; at least num_frames
+ * @throws FrameTransposeRowStrideError if row_stride is less than num_frames
+ */
+void
+transpose_to_planes(const WIB2Frame* frames,
+                    size_t num_frames,
+                    const int16_t* pedestals,
+                    int16_t* u_adcs,
+                    int16_t* v_adcs,
+                    int16_t* x_adcs,
+                    size_t row_stride);
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_FRAMETRANSPOSE_HPP_
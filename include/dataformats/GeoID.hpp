@@ -9,11 +9,17 @@
 #ifndef DATAFORMATS_INCLUDE_DATAFORMATS_GEOID_HPP_
 #define DATAFORMATS_INCLUDE_DATAFORMATS_GEOID_HPP_
 
+#include "dataformats/FieldTable.hpp"
+#include "dataformats/TextCodec.hpp"
+
+#include <charconv>
 #include <cstdint>
+#include <functional>
 #include <istream>
 #include <limits>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <tuple>
 
 namespace dunedaq {
@@ -68,8 +74,8 @@ struct GeoID
 
   uint32_t unused{ 0xFFFFFFFF }; ///< Ensure 64bit alignment // NOLINT(build/unsigned)
 
-  GeoID() {}
-  GeoID(SystemType const& type, uint16_t const& region, uint32_t const& element) // NOLINT(build/unsigned)
+  constexpr GeoID() {}
+  constexpr GeoID(SystemType const& type, uint16_t const& region, uint32_t const& element) // NOLINT(build/unsigned)
     : version(s_geo_id_version)
     , system_type(type)
     , region_id(region)
@@ -77,31 +83,57 @@ struct GeoID
   {}
 
   /**
-   * @brief Comparison operator (to allow GeoID to be used in std::map)
-   * @param other GeoID to compare
-   * @return The result of std::tuple compare using GeoID fields
+   * @brief Get the canonical 64-bit key of this GeoID
+   * @return system_type in bits 48-63, region_id in bits 32-47 and element_id in bits 0-31
+   *
+   * Keys compare in the same order as (system_type, region_id, element_id), and two GeoIDs have the same key
+   * exactly when they compare equal
+   */
+  constexpr uint64_t get_key() const noexcept // NOLINT(build/unsigned)
+  {
+    return (static_cast<uint64_t>(system_type) << 48) | (static_cast<uint64_t>(region_id) << 32) | // NOLINT
+           element_id;
+  }
+  /**
+   * @brief Create a GeoID from its 64-bit key
+   * @param key Key as returned by get_key()
+   * @return GeoID with the fields stored in the key
    */
-  bool operator<(const GeoID& other) const noexcept
+  static constexpr GeoID from_key(uint64_t key) noexcept // NOLINT(build/unsigned)
   {
-    return std::tuple(system_type, region_id, element_id) <
-           std::tuple(other.system_type, other.region_id, other.element_id);
+    return GeoID(static_cast<SystemType>(key >> 48),
+                 static_cast<uint16_t>(key >> 32), // NOLINT(build/unsigned)
+                 static_cast<uint32_t>(key));      // NOLINT(build/unsigned)
   }
 
+  /**
+   * @brief Comparison operator (to allow GeoID to be used in std::map)
+   * @param other GeoID to compare
+   * @return The result of comparing the GeoID keys
+   */
+  constexpr bool operator<(const GeoID& other) const noexcept { return get_key() < other.get_key(); }
+
   /**
    * @brief Comparison operator (to allow GeoID comparisons)
    * @param other GeoID to compare
-   * @return The result of std::tuple compare using GeoID fields
+   * @return The result of comparing the GeoID keys
    */
-  bool operator!=(const GeoID& other) const noexcept { return (*this) < other || other < (*this); }
+  constexpr bool operator!=(const GeoID& other) const noexcept { return get_key() != other.get_key(); }
 
   /**
    * @brief Comparison operator (to allow GeoID comparisons)
    * @param other GeoID to compare
-   * @return The result of std::tuple compare using GeoID fields
+   * @return The result of comparing the GeoID keys
    */
-  bool operator==(const GeoID& other) const noexcept { return !((*this) != other); }
+  constexpr bool operator==(const GeoID& other) const noexcept { return get_key() == other.get_key(); }
 
-  static std::string system_type_to_string(SystemType type)
+  static std::string system_type_to_string(SystemType type) { return std::string(system_type_to_string_view(type)); }
+  /**
+   * @brief Get the name of a SystemType without allocating
+   * @param type SystemType to name
+   * @return Name of the SystemType, or "Unknown"
+   */
+  static constexpr std::string_view system_type_to_string_view(SystemType type)
   {
     switch (type) {
       case SystemType::kTPC:
@@ -117,17 +149,27 @@ struct GeoID
     }
     return "Unknown";
   }
-  static SystemType string_to_system_type(std::string typestring)
+  /**
+   * @brief Get the SystemType named at the start of a string
+   * @param typestring String starting with a SystemType name, e.g. "TPC,"
+   * @return Matching SystemType, or SystemType::kInvalid
+   */
+  static constexpr SystemType string_to_system_type(std::string_view typestring)
   {
-    if (typestring.find("TPC") == 0)
-      return SystemType::kTPC;
-    if (typestring.find("PDS") == 0)
-      return SystemType::kPDS;
-    if (typestring.find("DataSelection") == 0)
-      return SystemType::kDataSelection;
-    if (typestring.find("NDLArTPC") == 0)
-      return SystemType::kNDLArTPC;
-    return SystemType::kInvalid;
+    // The names differ in their first character, so only one prefix needs comparing
+    auto starts_with = [&](std::string_view name) { return typestring.substr(0, name.size()) == name; };
+    switch (typestring.empty() ? '\0' : typestring[0]) {
+      case 'T':
+        return starts_with("TPC") ? SystemType::kTPC : SystemType::kInvalid;
+      case 'P':
+        return starts_with("PDS") ? SystemType::kPDS : SystemType::kInvalid;
+      case 'D':
+        return starts_with("DataSelection") ? SystemType::kDataSelection : SystemType::kInvalid;
+      case 'N':
+        return starts_with("NDLArTPC") ? SystemType::kNDLArTPC : SystemType::kInvalid;
+      default:
+        return SystemType::kInvalid;
+    }
   }
 };
 
@@ -185,7 +227,84 @@ operator>>(std::istream& is, GeoID& id)
   return is;
 }
 
+/**
+ * @brief Write the name of a GeoID::SystemType into a buffer, as operator<< does
+ * @param first Start of the buffer
+ * @param last End of the buffer
+ * @param type SystemType to write
+ * @return Pointer past the written text, or last and std::errc::value_too_large if the buffer is too small
+ */
+inline std::to_chars_result
+to_chars(char* first, char* last, GeoID::SystemType type) noexcept
+{
+  return detail::TextWriter(first, last).literal(GeoID::system_type_to_string_view(type)).result();
+}
+
+/**
+ * @brief Read a GeoID::SystemType from its name
+ *
+ * operator>> reads the name as a whitespace-delimited token, which in a GeoID includes the separator after it.
+ * The separator is left unread, so that the GeoID reads it like those after its other fields.
+ *
+ * @param first Start of the text
+ * @param last End of the text
+ * @param type SystemType to fill, set to kInvalid if the name is unknown
+ * @return Pointer past the name, or first and the error if there is none
+ */
+inline std::from_chars_result
+from_chars(const char* first, const char* last, GeoID::SystemType& type) noexcept
+{
+  detail::TextReader reader(first, last);
+  std::string_view name = reader.token();
+  auto result = reader.result();
+  if (result.ec == std::errc()) {
+    type = GeoID::string_to_system_type(name);
+    if (name.size() > 1 && name.back() == ',') {
+      --result.ptr;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Fields of a GeoID, in the order of its stream format
+ */
+template<>
+struct FieldTable<GeoID>
+{
+  /// FieldDescriptors of the GeoID fields
+  static constexpr auto fields = std::make_tuple(DATAFORMATS_FIELD(GeoID, system_type, "type"),
+                                                 DATAFORMATS_FIELD(GeoID, region_id, "region"),
+                                                 DATAFORMATS_FIELD(GeoID, element_id, "element"));
+};
+
 } // namespace dataformats
 } // namespace dunedaq
 
+/**
+ * @brief Hash function for GeoID (to allow GeoID to be used in std::unordered_map)
+ *
+ * Mixes the GeoID key with the MurmurHash3 finalizer, so that the low bits are usable directly as a
+ * power-of-two table index
+ */
+template<>
+struct std::hash<dunedaq::dataformats::GeoID>
+{
+  /**
+   * @brief Hash a GeoID
+   * @param id GeoID to hash
+   * @return Hash value of the GeoID key
+   */
+  size_t operator()(const dunedaq::dataformats::GeoID& id) const noexcept
+  {
+    uint64_t h = id.get_key(); // NOLINT(build/unsigned)
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+};
+
 #endif // DATAFORMATS_INCLUDE_DATAFORMATS_GEOID_HPP_
@@ -0,0 +1,311 @@
+/**
+ * @file GeoIDMap.hpp  Flat hash map keyed on GeoID
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_GEOIDMAP_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_GEOIDMAP_HPP_
+
+#include "dataformats/GeoID.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Open-addressing hash map from GeoID to T
+ *
+ * Keys are stored as GeoID::get_key() values in one flat array, so a lookup is a hash, a mask and a short
+ * linear probe over contiguous memory. The table size is always a power of two and the table is grown when it
+ * becomes more than 3/4 full. Erasing uses backward-shift deletion, so no tombstones accumulate.
+ *
+ * Pointers returned by find() and references returned by operator[] are invalidated by any insertion or erase.
+ * T must be default-constructible and move-assignable.
+ */
+template<typename T>
+class GeoIDMap
+{
+public:
+  /**
+   * @brief Construct a GeoIDMap
+   * @param capacity Number of elements to reserve space for
+   */
+  explicit GeoIDMap(size_t capacity = 0) { reserve(capacity); }
+
+  GeoIDMap(const GeoIDMap&) = default;            ///< GeoIDMap copy constructor
+  GeoIDMap& operator=(const GeoIDMap&) = default; ///< GeoIDMap copy assignment operator
+  /**
+   * @brief GeoIDMap move constructor
+   * @param other Map to move from. It is left empty, with no table, and usable
+   */
+  GeoIDMap(GeoIDMap&& other) noexcept
+    : m_occupied(std::move(other.m_occupied))
+    , m_keys(std::move(other.m_keys))
+    , m_values(std::move(other.m_values))
+    , m_size(std::exchange(other.m_size, 0))
+  {
+    other.m_occupied.clear();
+    other.m_keys.clear();
+    other.m_values.clear();
+  }
+  /**
+   * @brief GeoIDMap move assignment operator
+   * @param other Map to move from. It is left empty, with no table, and usable
+   * @return Reference to this map
+   */
+  GeoIDMap& operator=(GeoIDMap&& other) noexcept
+  {
+    if (&other != this) {
+      m_occupied = std::exchange(other.m_occupied, {});
+      m_keys = std::exchange(other.m_keys, {});
+      m_values = std::exchange(other.m_values, {});
+      m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Get the number of elements in the map
+   * @return Number of elements
+   */
+  size_t size() const noexcept { return m_size; }
+  /**
+   * @brief Check whether the map is empty
+   * @return True if the map contains no elements
+   */
+  bool empty() const noexcept { return m_size == 0; }
+
+  /**
+   * @brief Remove all elements, keeping the allocated table
+   */
+  void clear()
+  {
+    for (size_t slot = 0; slot < m_occupied.size(); ++slot) {
+      if (m_occupied[slot]) {
+        m_occupied[slot] = 0;
+        m_values[slot] = T();
+      }
+    }
+    m_size = 0;
+  }
+
+  /**
+   * @brief Make sure that the map can hold the given number of elements without rehashing
+   * @param capacity Number of elements to reserve space for
+   */
+  void reserve(size_t capacity)
+  {
+    size_t slots = s_min_slots;
+    while (slots * 3 / 4 < capacity) {
+      slots *= 2;
+    }
+    if (slots > m_occupied.size()) {
+      rehash_(slots);
+    }
+  }
+
+  /**
+   * @brief Look up a GeoID
+   * @param id GeoID to look up
+   * @return Pointer to the value stored for id, or nullptr if id is not in the map
+   */
+  T* find(const GeoID& id) noexcept
+  {
+    size_t slot = find_slot_(id.get_key());
+    return slot == s_npos ? nullptr : &m_values[slot];
+  }
+  /**
+   * @brief Look up a GeoID
+   * @param id GeoID to look up
+   * @return Pointer to the value stored for id, or nullptr if id is not in the map
+   */
+  const T* find(const GeoID& id) const noexcept
+  {
+    size_t slot = find_slot_(id.get_key());
+    return slot == s_npos ? nullptr : &m_values[slot];
+  }
+  /**
+   * @brief Check whether a GeoID is in the map
+   * @param id GeoID to look up
+   * @return True if id is in the map
+   */
+  bool contains(const GeoID& id) const noexcept { return find_slot_(id.get_key()) != s_npos; }
+
+  /**
+   * @brief Access the value stored for a GeoID, inserting a default-constructed value if it is not in the map
+   * @param id GeoID to look up
+   * @return Reference to the value stored for id
+   */
+  T& operator[](const GeoID& id) { return m_values[insert_slot_(id.get_key()).first]; }
+
+  /**
+   * @brief Insert a value for a GeoID if it is not already in the map
+   * @param id GeoID to insert
+   * @param value Value to store for id
+   * @return Pair of a pointer to the value stored for id and whether the insertion took place
+   */
+  std::pair<T*, bool> insert(const GeoID& id, T value)
+  {
+    auto [slot, inserted] = insert_slot_(id.get_key());
+    if (inserted) {
+      m_values[slot] = std::move(value);
+    }
+    return { &m_values[slot], inserted };
+  }
+
+  /**
+   * @brief Remove a GeoID from the map
+   * @param id GeoID to remove
+   * @return True if id was in the map
+   */
+  bool erase(const GeoID& id)
+  {
+    size_t hole = find_slot_(id.get_key());
+    if (hole == s_npos) {
+      return false;
+    }
+
+    // Shift back every following entry of the probe run that would not be found from its ideal slot once the
+    // hole is opened
+    size_t mask = m_occupied.size() - 1;
+    for (size_t slot = (hole + 1) & mask; m_occupied[slot]; slot = (slot + 1) & mask) {
+      size_t ideal = ideal_slot_(m_keys[slot]);
+      if (((slot - ideal) & mask) >= ((slot - hole) & mask)) {
+        m_keys[hole] = m_keys[slot];
+        m_values[hole] = std::move(m_values[slot]);
+        hole = slot;
+      }
+    }
+    m_occupied[hole] = 0;
+    m_values[hole] = T();
+    --m_size;
+    return true;
+  }
+
+  /**
+   * @brief Call a function for every element of the map, in unspecified order
+   * @param func Function called as func(const GeoID&, T&)
+   */
+  template<typename Func>
+  void for_each(Func&& func)
+  {
+    for (size_t slot = 0; slot < m_occupied.size(); ++slot) {
+      if (m_occupied[slot]) {
+        func(GeoID::from_key(m_keys[slot]), m_values[slot]);
+      }
+    }
+  }
+  /**
+   * @brief Call a function for every element of the map, in unspecified order
+   * @param func Function called as func(const GeoID&, const T&)
+   */
+  template<typename Func>
+  void for_each(Func&& func) const
+  {
+    for (size_t slot = 0; slot < m_occupied.size(); ++slot) {
+      if (m_occupied[slot]) {
+        func(GeoID::from_key(m_keys[slot]), m_values[slot]);
+      }
+    }
+  }
+
+private:
+  static constexpr size_t s_min_slots = 16;
+  static constexpr size_t s_npos = static_cast<size_t>(-1);
+
+  /**
+   * @brief Get the slot at which probing for a key starts
+   * @param key GeoID key
+   * @return Slot index
+   */
+  size_t ideal_slot_(uint64_t key) const noexcept // NOLINT(build/unsigned)
+  {
+    return std::hash<GeoID>()(GeoID::from_key(key)) & (m_occupied.size() - 1);
+  }
+
+  /**
+   * @brief Find the slot holding a key
+   * @param key GeoID key
+   * @return Slot index, or s_npos if the key is not in the map
+   */
+  size_t find_slot_(uint64_t key) const noexcept // NOLINT(build/unsigned)
+  {
+    // A moved-from map has no table until the next insertion
+    if (m_occupied.empty()) {
+      return s_npos;
+    }
+    size_t mask = m_occupied.size() - 1;
+    for (size_t slot = ideal_slot_(key); m_occupied[slot]; slot = (slot + 1) & mask) {
+      if (m_keys[slot] == key) {
+        return slot;
+      }
+    }
+    return s_npos;
+  }
+
+  /**
+   * @brief Find the slot holding a key, claiming a free slot for it if it is not in the map
+   * @param key GeoID key
+   * @return Pair of the slot index and whether a new slot was claimed
+   */
+  std::pair<size_t, bool> insert_slot_(uint64_t key) // NOLINT(build/unsigned)
+  {
+    size_t slot = find_slot_(key);
+    if (slot != s_npos) {
+      return { slot, false };
+    }
+    reserve(m_size + 1);
+    size_t mask = m_occupied.size() - 1;
+    for (slot = ideal_slot_(key); m_occupied[slot]; slot = (slot + 1) & mask) {
+    }
+    m_occupied[slot] = 1;
+    m_keys[slot] = key;
+    ++m_size;
+    return { slot, true };
+  }
+
+  /**
+   * @brief Move all elements into a new table
+   * @param slots Number of slots in the new table, a power of two
+   */
+  void rehash_(size_t slots)
+  {
+    std::vector<uint8_t> occupied(slots, 0); // NOLINT(build/unsigned)
+    std::vector<uint64_t> keys(slots);       // NOLINT(build/unsigned)
+    std::vector<T> values(slots);
+    std::swap(occupied, m_occupied);
+    std::swap(keys, m_keys);
+    std::swap(values, m_values);
+
+    size_t mask = slots - 1;
+    for (size_t old_slot = 0; old_slot < occupied.size(); ++old_slot) {
+      if (occupied[old_slot]) {
+        size_t slot = ideal_slot_(keys[old_slot]);
+        while (m_occupied[slot]) {
+          slot = (slot + 1) & mask;
+        }
+        m_occupied[slot] = 1;
+        m_keys[slot] = keys[old_slot];
+        m_values[slot] = std::move(values[old_slot]);
+      }
+    }
+  }
+
+  std::vector<uint8_t> m_occupied;  ///< Whether each slot holds an element // NOLINT(build/unsigned)
+  std::vector<uint64_t> m_keys;     ///< GeoID key stored in each slot // NOLINT(build/unsigned)
+  std::vector<T> m_values;          ///< Value stored in each slot
+  size_t m_size{ 0 };               ///< Number of elements in the map
+};
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_GEOIDMAP_HPP_
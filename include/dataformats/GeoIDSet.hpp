@@ -0,0 +1,312 @@
+/**
+ * @file GeoIDSet.hpp  Dense bitmap set of GeoIDs
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_GEOIDSET_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_GEOIDSET_HPP_
+
+#include "dataformats/Fragment.hpp"
+#include "dataformats/GeoID.hpp"
+#include "dataformats/TriggerRecordHeader.hpp"
+
+#include "ers/Issue.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace dunedaq {
+/**
+ * @brief An ERS Error that indicates that a GeoID element_id is too large to be stored in a GeoIDSet
+ * @param gse_element_id element_id that was supplied
+ * @param gse_max Maximum allowed element_id
+ * @cond Doxygen doesn't like ERS macros LCOV_EXCL_START
+ */
+ERS_DECLARE_ISSUE(dataformats,
+                  GeoIDSetElementError,
+                  "GeoID element_id " << gse_element_id << " is greater than the maximum GeoIDSet element_id "
+                                      << gse_max,
+                  ((size_t)gse_element_id)((size_t)gse_max)) // NOLINT
+                                                             /// @endcond LCOV_EXCL_STOP
+
+namespace dataformats {
+
+/**
+ * @brief Set of GeoIDs stored as one bitmap over element_id per (system_type, region_id) pair
+ *
+ * Insertion and membership tests are a region lookup plus a single bit operation, and union, intersection and
+ * difference combine 64 element_ids per instruction. Bitmaps grow to the largest element_id inserted in their
+ * region, so the set is meant for the densely numbered element_ids of readout links, not for arbitrary
+ * identifiers.
+ */
+class GeoIDSet
+{
+public:
+  /**
+   * @brief Largest element_id that can be stored, which bounds the size of one bitmap to 2 MiB
+   */
+  static constexpr uint32_t s_max_element_id = (1U << 24) - 1; // NOLINT(build/unsigned)
+
+  /**
+   * @brief Build the set of GeoIDs requested by a TriggerRecordHeader
+   * @param header TriggerRecordHeader whose ComponentRequests to add
+   * @param duplicates If not nullptr, receives the GeoIDs that are requested more than once
+   * @return Set of requested GeoIDs
+   * @throws GeoIDSetElementError if a requested element_id is greater than s_max_element_id
+   */
+  static GeoIDSet from_components(const TriggerRecordHeader& header, GeoIDSet* duplicates = nullptr)
+  {
+    GeoIDSet set;
+    for (auto& component : header) {
+      if (!set.insert(component.component) && duplicates != nullptr) {
+        duplicates->insert(component.component);
+      }
+    }
+    return set;
+  }
+
+  /**
+   * @brief Build the set of GeoIDs of a list of Fragments
+   * @param fragments Fragments whose element_ids to add, e.g. TriggerRecord::get_fragments_ref()
+   * @param duplicates If not nullptr, receives the GeoIDs that appear in more than one Fragment
+   * @return Set of Fragment GeoIDs
+   * @throws GeoIDSetElementError if a Fragment element_id is greater than s_max_element_id
+   */
+  static GeoIDSet from_fragments(const std::vector<std::unique_ptr<Fragment>>& fragments,
+                                 GeoIDSet* duplicates = nullptr)
+  {
+    GeoIDSet set;
+    for (auto& fragment : fragments) {
+      auto element_id = fragment->get_element_id();
+      if (!set.insert(element_id) && duplicates != nullptr) {
+        duplicates->insert(element_id);
+      }
+    }
+    return set;
+  }
+
+  /**
+   * @brief Add a GeoID to the set
+   * @param id GeoID to add
+   * @return True if id was not already in the set
+   * @throws GeoIDSetElementError if id.element_id is greater than s_max_element_id
+   */
+  bool insert(const GeoID& id)
+  {
+    if (id.element_id > s_max_element_id) {
+      throw GeoIDSetElementError(ERS_HERE, id.element_id, s_max_element_id);
+    }
+    auto& words = m_bitmaps[region_key_(id)];
+    size_t word = id.element_id / 64;
+    if (word >= words.size()) {
+      words.resize(word + 1, 0);
+    }
+    uint64_t bit = 1ULL << (id.element_id % 64); // NOLINT(build/unsigned)
+    bool inserted = (words[word] & bit) == 0;
+    words[word] |= bit;
+    return inserted;
+  }
+
+  /**
+   * @brief Remove a GeoID from the set
+   * @param id GeoID to remove
+   * @return True if id was in the set
+   */
+  bool erase(const GeoID& id)
+  {
+    auto region = m_bitmaps.find(region_key_(id));
+    size_t word = id.element_id / 64;
+    if (region == m_bitmaps.end() || word >= region->second.size()) {
+      return false;
+    }
+    uint64_t bit = 1ULL << (id.element_id % 64); // NOLINT(build/unsigned)
+    bool erased = (region->second[word] & bit) != 0;
+    region->second[word] &= ~bit;
+    return erased;
+  }
+
+  /**
+   * @brief Check whether a GeoID is in the set
+   * @param id GeoID to look up
+   * @return True if id is in the set
+   */
+  bool contains(const GeoID& id) const
+  {
+    auto region = m_bitmaps.find(region_key_(id));
+    size_t word = id.element_id / 64;
+    if (region == m_bitmaps.end() || word >= region->second.size()) {
+      return false;
+    }
+    return (region->second[word] >> (id.element_id % 64)) & 1;
+  }
+
+  /**
+   * @brief Get the number of GeoIDs in the set
+   * @return Number of GeoIDs, counted with one popcount per 64 element_ids
+   */
+  size_t size() const
+  {
+    size_t count = 0;
+    for (auto& [key, words] : m_bitmaps) {
+      for (auto word : words) {
+        count += __builtin_popcountll(word);
+      }
+    }
+    return count;
+  }
+  /**
+   * @brief Check whether the set is empty
+   * @return True if the set contains no GeoIDs
+   */
+  bool empty() const
+  {
+    for (auto& [key, words] : m_bitmaps) {
+      if (std::any_of(words.begin(), words.end(), [](uint64_t word) { return word != 0; })) { // NOLINT
+        return false;
+      }
+    }
+    return true;
+  }
+  /**
+   * @brief Remove all GeoIDs from the set
+   */
+  void clear() { m_bitmaps.clear(); }
+
+  /**
+   * @brief Add all GeoIDs of another set to this one
+   * @param other Set to add
+   * @return Reference to this set
+   */
+  GeoIDSet& operator|=(const GeoIDSet& other)
+  {
+    for (auto& [key, other_words] : other.m_bitmaps) {
+      auto& words = m_bitmaps[key];
+      if (words.size() < other_words.size()) {
+        words.resize(other_words.size(), 0);
+      }
+      for (size_t idx = 0; idx < other_words.size(); ++idx) {
+        words[idx] |= other_words[idx];
+      }
+    }
+    return *this;
+  }
+  /**
+   * @brief Remove the GeoIDs that are not in another set
+   * @param other Set to intersect with
+   * @return Reference to this set
+   */
+  GeoIDSet& operator&=(const GeoIDSet& other)
+  {
+    for (auto region = m_bitmaps.begin(); region != m_bitmaps.end();) {
+      auto other_region = other.m_bitmaps.find(region->first);
+      if (other_region == other.m_bitmaps.end()) {
+        region = m_bitmaps.erase(region);
+        continue;
+      }
+      auto& words = region->second;
+      auto& other_words = other_region->second;
+      words.resize(std::min(words.size(), other_words.size()));
+      for (size_t idx = 0; idx < words.size(); ++idx) {
+        words[idx] &= other_words[idx];
+      }
+      ++region;
+    }
+    return *this;
+  }
+  /**
+   * @brief Remove the GeoIDs that are in another set
+   * @param other Set to subtract
+   * @return Reference to this set
+   */
+  GeoIDSet& operator-=(const GeoIDSet& other)
+  {
+    for (auto& [key, words] : m_bitmaps) {
+      auto other_region = other.m_bitmaps.find(key);
+      if (other_region == other.m_bitmaps.end()) {
+        continue;
+      }
+      auto& other_words = other_region->second;
+      for (size_t idx = 0; idx < std::min(words.size(), other_words.size()); ++idx) {
+        words[idx] &= ~other_words[idx];
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Get the union of two sets
+   * @param lhs First set
+   * @param rhs Second set
+   * @return Set of GeoIDs in either set
+   */
+  friend GeoIDSet operator|(GeoIDSet lhs, const GeoIDSet& rhs) { return lhs |= rhs; }
+  /**
+   * @brief Get the intersection of two sets
+   * @param lhs First set
+   * @param rhs Second set
+   * @return Set of GeoIDs in both sets
+   */
+  friend GeoIDSet operator&(GeoIDSet lhs, const GeoIDSet& rhs) { return lhs &= rhs; }
+  /**
+   * @brief Get the difference of two sets
+   * @param lhs First set
+   * @param rhs Set to subtract
+   * @return Set of GeoIDs in lhs but not in rhs
+   */
+  friend GeoIDSet operator-(GeoIDSet lhs, const GeoIDSet& rhs) { return lhs -= rhs; }
+
+  /**
+   * @brief Call a function for every GeoID in the set, in increasing GeoID order
+   * @param func Function called as func(const GeoID&)
+   */
+  template<typename Func>
+  void for_each(Func&& func) const
+  {
+    for (auto& [key, words] : m_bitmaps) {
+      for (size_t idx = 0; idx < words.size(); ++idx) {
+        for (uint64_t word = words[idx]; word != 0; word &= word - 1) { // NOLINT(build/unsigned)
+          func(GeoID(static_cast<GeoID::SystemType>(key >> 16),
+                     static_cast<uint16_t>(key),                             // NOLINT(build/unsigned)
+                     static_cast<uint32_t>(idx * 64 + __builtin_ctzll(word)))); // NOLINT(build/unsigned)
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Get the GeoIDs in the set
+   * @return Vector of the GeoIDs in the set, in increasing GeoID order
+   */
+  std::vector<GeoID> to_vector() const
+  {
+    std::vector<GeoID> ids;
+    ids.reserve(size());
+    for_each([&](const GeoID& id) { ids.push_back(id); });
+    return ids;
+  }
+
+private:
+  /**
+   * @brief Get the key of the bitmap holding a GeoID
+   * @param id GeoID
+   * @return system_type in the upper and region_id in the lower 16 bits
+   */
+  static uint32_t region_key_(const GeoID& id) noexcept // NOLINT(build/unsigned)
+  {
+    return static_cast<uint32_t>(id.get_key() >> 32); // NOLINT(build/unsigned)
+  }
+
+  std::map<uint32_t, std::vector<uint64_t>> m_bitmaps; ///< Bitmap over element_id per region // NOLINT(build/unsigned)
+};
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_GEOIDSET_HPP_
@@ -0,0 +1,286 @@
+/**
+ * @file JsonWriter.hpp  Streaming JSON writer for the dataformats header structs
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_JSONWRITER_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_JSONWRITER_HPP_
+
+#include "dataformats/ComponentRequest.hpp"
+#include "dataformats/FieldTable.hpp"
+#include "dataformats/Fragment.hpp"
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/GeoID.hpp"
+#include "dataformats/TriggerRecord.hpp"
+#include "dataformats/TriggerRecordHeader.hpp"
+#include "dataformats/TriggerRecordHeaderData.hpp"
+#include "dataformats/detail/TextConversion.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Writes JSON for the dataformats structs into a reusable buffer
+ *
+ * Structs with a FieldTable are written as objects keyed by their field names, with GeoID::SystemType as its
+ * name string. Every write appends to the buffer, and clear() empties it while keeping its memory, so that a
+ * writer reused for many records stops allocating once the buffer has grown to the largest record.
+ *
+ * A typical monitoring loop writes one record, adds newline() to produce JSON Lines, hands view() to the
+ * output and calls clear().
+ */
+class JsonWriter
+{
+public:
+  /**
+   * @brief Construct a JsonWriter
+   * @param capacity Initial size of the buffer, in bytes
+   */
+  explicit JsonWriter(size_t capacity = 4096)
+    : m_buffer(capacity)
+  {}
+
+  /**
+   * @brief Write a struct that has a FieldTable as a JSON object
+   * @param value Struct to write, e.g. a FragmentHeader, TriggerRecordHeaderData, ComponentRequest or GeoID
+   * @return Reference to this JsonWriter
+   */
+  template<typename T>
+  JsonWriter& write(const T& value)
+  {
+    static_assert(has_field_table_v<T>, "JsonWriter::write requires a FieldTable for the written type");
+    char* first = reserve_(max_size_<T>());
+    m_size += write_value_(first, value) - first;
+    return *this;
+  }
+
+  /**
+   * @brief Write a TriggerRecordHeader as a JSON object with its header data and its component requests
+   * @param header TriggerRecordHeader to write
+   * @return Reference to this JsonWriter
+   */
+  JsonWriter& write(const TriggerRecordHeader& header)
+  {
+    literal_("{\"header\":");
+    value_(header.get_header());
+    literal_(",\"components\":[");
+    for (auto component = header.begin(); component != header.end(); ++component) {
+      if (component != header.begin()) {
+        literal_(",");
+      }
+      value_(*component);
+    }
+    literal_("]}");
+    return *this;
+  }
+
+  /**
+   * @brief Write a summary of a TriggerRecord as a JSON object
+   *
+   * The summary holds the TriggerRecordHeaderData, the number of Fragments and their total size, the number of
+   * Fragments per FragmentType name, the number of Fragments with any error bit set and the OR of all Fragment
+   * error bits.
+   *
+   * @param record TriggerRecord to summarize
+   * @return Reference to this JsonWriter
+   */
+  JsonWriter& write(const TriggerRecord& record)
+  {
+    constexpr size_t num_types = std::size(s_named_fragment_types);
+    size_t type_counts[num_types + 1] = {};
+    size_t total_size = 0;
+    size_t num_with_errors = 0;
+    uint32_t error_bits = 0; // NOLINT(build/unsigned)
+
+    for (auto& fragment : record.get_fragments_ref()) {
+      size_t type_idx = 0;
+      while (type_idx < num_types && s_named_fragment_types[type_idx] != fragment->get_fragment_type()) {
+        ++type_idx;
+      }
+      ++type_counts[type_idx];
+      total_size += fragment->get_size();
+      auto fragment_error_bits = fragment->get_header().error_bits;
+      num_with_errors += fragment_error_bits != 0;
+      error_bits |= fragment_error_bits;
+    }
+
+    literal_("{\"header\":");
+    value_(record.get_header_data());
+    literal_(",\"num_fragments\":");
+    number_(record.get_fragments_ref().size());
+    literal_(",\"total_fragment_size\":");
+    number_(total_size);
+    literal_(",\"fragment_counts\":{");
+    bool first = true;
+    for (size_t type_idx = 0; type_idx <= num_types; ++type_idx) {
+      if (type_counts[type_idx] == 0) {
+        continue;
+      }
+      literal_(first ? "\"" : ",\"");
+      first = false;
+      literal_(type_idx < num_types ? fragment_type_to_string_view(s_named_fragment_types[type_idx]) : "Unknown");
+      literal_("\":");
+      number_(type_counts[type_idx]);
+    }
+    literal_("},\"num_fragments_with_errors\":");
+    number_(num_with_errors);
+    literal_(",\"fragment_error_bits\":");
+    number_(error_bits);
+    literal_("}");
+    return *this;
+  }
+
+  /**
+   * @brief Write a newline, e.g. to separate records in JSON Lines output
+   * @return Reference to this JsonWriter
+   */
+  JsonWriter& newline()
+  {
+    literal_("\n");
+    return *this;
+  }
+
+  /**
+   * @brief Get the text written so far
+   * @return View of the buffer contents, valid until the next write or clear()
+   */
+  std::string_view view() const noexcept { return std::string_view(m_buffer.data(), m_size); }
+  /**
+   * @brief Get a pointer to the text written so far
+   * @return Pointer to the buffer contents, which are not null-terminated
+   */
+  const char* data() const noexcept { return m_buffer.data(); }
+  /**
+   * @brief Get the size of the text written so far
+   * @return Number of bytes written
+   */
+  size_t size() const noexcept { return m_size; }
+  /**
+   * @brief Discard the text written so far, keeping the buffer memory for reuse
+   */
+  void clear() noexcept { m_size = 0; }
+
+private:
+  /**
+   * @brief Maximum number of characters written for one number
+   */
+  static constexpr size_t s_max_number_size = 24;
+
+  /**
+   * @brief Make room at the end of the buffer
+   * @param size Number of bytes needed
+   * @return Pointer to the first free byte
+   */
+  char* reserve_(size_t size)
+  {
+    if (m_buffer.size() - m_size < size) {
+      m_buffer.resize(std::max(2 * m_buffer.size(), m_size + size));
+    }
+    return m_buffer.data() + m_size;
+  }
+
+  void literal_(std::string_view text)
+  {
+    memcpy(reserve_(text.size()), text.data(), text.size());
+    m_size += text.size();
+  }
+
+  template<typename T>
+  void number_(T value)
+  {
+    char* first = reserve_(s_max_number_size);
+    m_size += write_value_(first, value) - first;
+  }
+
+  template<typename T>
+  void value_(const T& value)
+  {
+    char* first = reserve_(max_size_<T>());
+    m_size += write_value_(first, value) - first;
+  }
+
+  /**
+   * @brief Get an upper bound on the JSON size of a value, so that it can be written without bounds checks
+   * @return Maximum number of bytes written by write_value_() for a T
+   */
+  template<typename T>
+  static constexpr size_t max_size_()
+  {
+    if constexpr (has_field_table_v<T>) {
+      size_t size = 2;
+      for_each_field<T>([&](const auto& field) {
+        using field_t = typename std::decay_t<decltype(field)>::value_type;
+        size += field.name.size() + 4 + max_size_<field_t>();
+      });
+      return size;
+    } else if constexpr (std::is_same_v<T, GeoID::SystemType>) {
+      return 2 + GeoID::system_type_to_string_view(GeoID::SystemType::kDataSelection).size();
+    } else {
+      return s_max_number_size;
+    }
+  }
+
+  static char* copy_(char* out, std::string_view text) noexcept
+  {
+    memcpy(out, text.data(), text.size());
+    return out + text.size();
+  }
+
+  /**
+   * @brief Write a value into a buffer known to have room for max_size_<T>() bytes
+   * @param out Buffer to write to
+   * @param value Value to write
+   * @return Pointer past the written bytes
+   */
+  template<typename T>
+  static char* write_value_(char* out, const T& value) noexcept
+  {
+    if constexpr (has_field_table_v<T>) {
+      // Every field is preceded by a separator, and the first one is overwritten by the opening brace
+      char* start = out;
+      for_each_field<T>([&](const auto& field) {
+        *out++ = ',';
+        *out++ = '"';
+        out = copy_(out, field.name);
+        *out++ = '"';
+        *out++ = ':';
+        out = write_value_(out, field.get(value));
+      });
+      *start = '{';
+      *out++ = '}';
+      return out;
+    } else if constexpr (std::is_same_v<T, GeoID::SystemType>) {
+      *out++ = '"';
+      out = copy_(out, GeoID::system_type_to_string_view(value));
+      *out++ = '"';
+      return out;
+    } else if constexpr (std::is_enum_v<T>) {
+      return write_value_(out, static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_unsigned_v<T>) {
+      return detail::write_decimal(out, value);
+    } else {
+      return std::to_chars(out, out + s_max_number_size, value).ptr;
+    }
+  }
+
+  std::vector<char> m_buffer; ///< Output buffer, grown as needed and reused after clear()
+  size_t m_size{ 0 };         ///< Number of bytes of m_buffer holding output
+};
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_JSONWRITER_HPP_
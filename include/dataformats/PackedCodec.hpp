@@ -0,0 +1,124 @@
+/**
+ * @file PackedCodec.hpp  Packed binary encoding of structs with a FieldTable
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_PACKEDCODEC_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_PACKEDCODEC_HPP_
+
+#include "dataformats/FieldTable.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Get the packed size of a struct: the sum of the sizes of its fields, without padding
+ * @tparam T Struct with a FieldTable, or a trivially-copyable field type
+ * @return Number of bytes written by encode_packed() for one T
+ */
+template<typename T>
+constexpr size_t
+packed_size()
+{
+  if constexpr (has_field_table_v<T>) {
+    size_t size = 0;
+    for_each_field<T>([&](const auto& field) {
+      using field_t = typename std::decay_t<decltype(field)>::value_type;
+      size += packed_size<field_t>();
+    });
+    return size;
+  } else {
+    static_assert(std::is_trivially_copyable_v<T>, "Fields without a FieldTable must be trivially copyable");
+    return sizeof(T);
+  }
+}
+
+/**
+ * @brief Packed size of a struct, see packed_size()
+ */
+template<typename T>
+constexpr size_t packed_size_v = packed_size<T>();
+
+/**
+ * @brief Write the fields of a struct back to back, in table order and host byte order
+ * @param value Struct to encode
+ * @param out Buffer with room for packed_size_v<T> bytes
+ * @return Pointer past the encoded bytes
+ */
+template<typename T>
+char*
+encode_packed(const T& value, char* out) noexcept
+{
+  if constexpr (has_field_table_v<T>) {
+    for_each_field<T>([&](const auto& field) { out = encode_packed(field.get(value), out); });
+    return out;
+  } else {
+    memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+  }
+}
+
+/**
+ * @brief Read the fields of a struct written by encode_packed()
+ * @param in Buffer holding packed_size_v<T> encoded bytes
+ * @param value Struct to fill. Fields not in its FieldTable are left unchanged
+ * @return Pointer past the decoded bytes
+ */
+template<typename T>
+const char*
+decode_packed(const char* in, T& value) noexcept
+{
+  if constexpr (has_field_table_v<T>) {
+    for_each_field<T>([&](const auto& field) { in = decode_packed(in, field.get(value)); });
+    return in;
+  } else {
+    memcpy(&value, in, sizeof(T));
+    return in + sizeof(T);
+  }
+}
+
+/**
+ * @brief Encode an array of structs back to back
+ * @param values Structs to encode
+ * @param count Number of structs
+ * @param out Buffer with room for count * packed_size_v<T> bytes
+ * @return Pointer past the encoded bytes
+ */
+template<typename T>
+char*
+encode_packed(const T* values, size_t count, char* out) noexcept
+{
+  for (size_t idx = 0; idx < count; ++idx) {
+    out = encode_packed(values[idx], out);
+  }
+  return out;
+}
+
+/**
+ * @brief Decode an array of structs written by encode_packed()
+ * @param in Buffer holding count * packed_size_v<T> encoded bytes
+ * @param values Structs to fill
+ * @param count Number of structs
+ * @return Pointer past the decoded bytes
+ */
+template<typename T>
+const char*
+decode_packed(const char* in, T* values, size_t count) noexcept
+{
+  for (size_t idx = 0; idx < count; ++idx) {
+    in = decode_packed(in, values[idx]);
+  }
+  return in;
+}
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_PACKEDCODEC_HPP_
@@ -0,0 +1,93 @@
+/**
+ * @file TextCodec.hpp  to_chars/from_chars for the structs with a FieldTable
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_TEXTCODEC_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_TEXTCODEC_HPP_
+
+#include "dataformats/FieldTable.hpp"
+#include "dataformats/detail/TextConversion.hpp"
+
+#include <charconv>
+#include <type_traits>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Write a struct into a buffer, in the same format as its operator<<
+ *
+ * Fields are written in table order as "name: value", separated by ", ". Integers are written in the base given
+ * by their FieldFormat, kInline fields are written without their name, and other fields with their own to_chars.
+ *
+ * @param first Start of the buffer
+ * @param last End of the buffer
+ * @param value Struct to write
+ * @return Pointer past the written text, or last and std::errc::value_too_large if the buffer is too small
+ */
+template<typename T, std::enable_if_t<has_field_table_v<T>, int> = 0>
+std::to_chars_result
+to_chars(char* first, char* last, const T& value) noexcept
+{
+  detail::TextWriter writer(first, last);
+  bool first_field = true;
+  for_each_field<T>([&](const auto& field) {
+    using field_t = typename std::decay_t<decltype(field)>::value_type;
+    if (!first_field) {
+      writer.literal(", ");
+    }
+    first_field = false;
+    if (field.format != FieldFormat::kInline) {
+      writer.literal(field.name).literal(": ");
+    }
+    if constexpr (std::is_integral_v<field_t>) {
+      writer.number(field.get(value), field.format == FieldFormat::kHex ? 16 : 10);
+    } else {
+      writer.object(field.get(value));
+    }
+  });
+  return writer.result();
+}
+
+/**
+ * @brief Read a struct from text written by to_chars or operator<<
+ *
+ * As operator>> does, the field names and separators are read as whitespace-delimited tokens and discarded.
+ *
+ * @param first Start of the text
+ * @param last End of the text
+ * @param value Struct to fill
+ * @return Pointer past the text that was read, or first and the error if the text could not be parsed
+ */
+template<typename T, std::enable_if_t<has_field_table_v<T>, int> = 0>
+std::from_chars_result
+from_chars(const char* first, const char* last, T& value) noexcept
+{
+  detail::TextReader reader(first, last);
+  bool first_field = true;
+  for_each_field<T>([&](const auto& field) {
+    using field_t = typename std::decay_t<decltype(field)>::value_type;
+    if (!first_field) {
+      reader.skip_token();
+    }
+    first_field = false;
+    if (field.format != FieldFormat::kInline) {
+      reader.skip_token();
+    }
+    if constexpr (std::is_integral_v<field_t>) {
+      reader.number(field.get(value), field.format == FieldFormat::kHex ? 16 : 10);
+    } else {
+      reader.object(field.get(value));
+    }
+  });
+  return reader.result();
+}
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_TEXTCODEC_HPP_
@@ -0,0 +1,186 @@
+/**
+ * @file TimestampContinuity.hpp  Detection of missing, duplicated and out-of-order frames in frame payloads
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_TIMESTAMPCONTINUITY_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_TIMESTAMPCONTINUITY_HPP_
+
+#include "dataformats/Fragment.hpp"
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/Types.hpp"
+#include "dataformats/wib/WIBFrame.hpp"
+#include "dataformats/wib2/WIB2Frame.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Timestamp difference between consecutive frames of a frame type, in timestamp ticks
+ *
+ * Only defined for frame types whose step is known; other types must be given a step explicitly.
+ */
+template<typename Frame>
+struct FrameTimestampStep;
+
+/// @cond Specializations are documented by the primary template
+template<>
+struct FrameTimestampStep<WIBFrame>
+{
+  static constexpr timestamp_t value = 25;
+};
+template<>
+struct FrameTimestampStep<WIB2Frame>
+{
+  static constexpr timestamp_t value = 32;
+};
+/// @endcond
+
+/**
+ * @brief Summary of the timestamp discontinuities in a sequence of frames
+ *
+ * Each pair of consecutive frames whose timestamp step differs from the expected one counts as exactly one of
+ * gap, duplicate, out-of-order or irregular step.
+ */
+struct TimestampContinuityReport
+{
+  size_t num_frames{ 0 };          ///< Number of frames checked
+  size_t num_gaps{ 0 };            ///< Steps larger than expected
+  size_t num_missing_frames{ 0 };  ///< Frames missing in the gaps, at the expected step
+  size_t num_duplicates{ 0 };      ///< Steps of zero
+  size_t num_out_of_order{ 0 };    ///< Steps going back in time
+  size_t num_irregular_steps{ 0 }; ///< Steps between zero and the expected step
+  size_t first_discontinuity{ 0 }; ///< Index of the first frame not one step after its predecessor, or num_frames
+
+  /**
+   * @brief Whether every frame is one expected step after its predecessor
+   */
+  bool is_continuous() const noexcept { return first_discontinuity == num_frames; }
+
+  /**
+   * @brief Count one discontinuity
+   * @param index Index of the frame after the discontinuity
+   * @param previous Timestamp of the frame before it
+   * @param current Timestamp of the frame after it
+   * @param expected_step Expected timestamp step
+   */
+  void add(size_t index, timestamp_t previous, timestamp_t current, timestamp_t expected_step) noexcept
+  {
+    first_discontinuity = std::min(first_discontinuity, index);
+    if (current < previous) {
+      ++num_out_of_order;
+    } else if (current == previous) {
+      ++num_duplicates;
+    } else if (current - previous < expected_step) {
+      ++num_irregular_steps;
+    } else {
+      ++num_gaps;
+      num_missing_frames += (current - previous - 1) / expected_step;
+    }
+  }
+};
+
+/**
+ * @brief Call a visitor for every pair of consecutive frames whose timestamp step is not the expected one
+ *
+ * Frames are checked in blocks: each block is first scanned without branches, and only blocks containing a
+ * discontinuity are scanned again to find it, so continuous data costs one load and a few integer operations
+ * per frame.
+ *
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param expected_step Expected timestamp step between consecutive frames
+ * @param visitor Callable invoked as visitor(index, previous_timestamp, timestamp) for each frame index whose
+ * timestamp is not expected_step after the one of frame index - 1
+ * @return Number of discontinuities found
+ */
+template<typename Frame, typename Visitor>
+size_t
+for_each_timestamp_discontinuity(const Frame* frames, size_t num_frames, timestamp_t expected_step, Visitor&& visitor)
+{
+  constexpr size_t block_size = 64;
+  size_t num_discontinuities = 0;
+  for (size_t begin = 1; begin < num_frames; begin += block_size) {
+    const size_t end = std::min(begin + block_size, num_frames);
+    timestamp_t previous = frames[begin - 1].get_timestamp();
+    timestamp_t mismatch = 0;
+    for (size_t i = begin; i < end; ++i) {
+      timestamp_t current = frames[i].get_timestamp();
+      mismatch |= (current - previous) ^ expected_step;
+      previous = current;
+    }
+    if (mismatch == 0) {
+      continue;
+    }
+    previous = frames[begin - 1].get_timestamp();
+    for (size_t i = begin; i < end; ++i) {
+      timestamp_t current = frames[i].get_timestamp();
+      if (current - previous != expected_step) {
+        visitor(i, previous, current);
+        ++num_discontinuities;
+      }
+      previous = current;
+    }
+  }
+  return num_discontinuities;
+}
+
+/**
+ * @brief Check that the timestamps of a sequence of frames advance by a fixed step
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param expected_step Expected timestamp step between consecutive frames
+ * @return Summary of the discontinuities
+ */
+template<typename Frame>
+TimestampContinuityReport
+check_timestamp_continuity(const Frame* frames,
+                           size_t num_frames,
+                           timestamp_t expected_step = FrameTimestampStep<Frame>::value)
+{
+  TimestampContinuityReport report;
+  report.num_frames = num_frames;
+  report.first_discontinuity = num_frames;
+  for_each_timestamp_discontinuity(
+    frames, num_frames, expected_step, [&](size_t index, timestamp_t previous, timestamp_t current) {
+      report.add(index, previous, current, expected_step);
+    });
+  return report;
+}
+
+/**
+ * @brief Check that the timestamps of the frames in a Fragment payload advance by a fixed step
+ *
+ * The frame type is given explicitly, since the FragmentType does not say which WIB version produced the payload.
+ * A partial frame at the end of the payload is ignored.
+ *
+ * @param fragment Fragment whose payload is an array of Frame
+ * @param expected_step Expected timestamp step between consecutive frames
+ * @param set_incomplete Whether to set FragmentErrorBits::kIncomplete in the Fragment if frames are missing
+ * @return Summary of the discontinuities
+ */
+template<typename Frame>
+TimestampContinuityReport
+check_timestamp_continuity(Fragment& fragment,
+                           timestamp_t expected_step = FrameTimestampStep<Frame>::value,
+                           bool set_incomplete = true)
+{
+  auto report = check_timestamp_continuity(static_cast<const Frame*>(fragment.get_data()),
+                                           (fragment.get_size() - sizeof(FragmentHeader)) / sizeof(Frame),
+                                           expected_step);
+  if (set_incomplete && report.num_gaps != 0) {
+    fragment.set_error_bit(FragmentErrorBits::kIncomplete, true);
+  }
+  return report;
+}
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_TIMESTAMPCONTINUITY_HPP_
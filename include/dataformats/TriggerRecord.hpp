@@ -38,10 +38,10 @@ public:
 
   /**
    * @brief Construct a TriggerRecord using the given TriggerRecordHeader
-   * @param header TriggerRecordHeader to *copy* into the TriggerRecord
+   * @param header TriggerRecordHeader to move into the TriggerRecord (pass an rvalue to avoid copying the header)
    */
-  explicit TriggerRecord(TriggerRecordHeader const& header)
-    : m_header(header)
+  explicit TriggerRecord(TriggerRecordHeader header)
+    : m_header(std::move(header))
     , m_fragments()
   {}
   virtual ~TriggerRecord() = default; ///< TriggerRecord default destructor
@@ -56,11 +56,16 @@ public:
    * @return A reference to the TriggerRecordHeader
    */
   TriggerRecordHeader& get_header_ref() { return m_header; }
+  /**
+   * @brief Get a read-only handle to the TriggerRecordHeader
+   * @return A const reference to the TriggerRecordHeader
+   */
+  const TriggerRecordHeader& get_header_ref() const { return m_header; }
   /**
    * @brief Set the TriggerRecordHeader to the given TriggerRecordHeader object
-   * @param header new TriggerRecordHeader to use
+   * @param header new TriggerRecordHeader to use (pass an rvalue to avoid copying the header)
    */
-  void set_header(TriggerRecordHeader header) { m_header = header; }
+  void set_header(TriggerRecordHeader header) { m_header = std::move(header); }
   /**
    * @brief Get a copy of the TriggerRecordHeaderData from the TriggerRecordHeader
    * @return Copy of the TriggerRecordHeaderData struct from the TriggerRecordHeader
@@ -72,6 +77,11 @@ public:
    * @return A reference to the Fragments vector
    */
   std::vector<std::unique_ptr<Fragment>>& get_fragments_ref() { return m_fragments; }
+  /**
+   * @brief Get a read-only handle to the Fragments
+   * @return A const reference to the Fragments vector
+   */
+  const std::vector<std::unique_ptr<Fragment>>& get_fragments_ref() const { return m_fragments; }
   /**
    * @brief Set the Fragments vector to the given vector of Fragments
    * @param fragments Fragments vector to use
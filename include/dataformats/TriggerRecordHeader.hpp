@@ -12,12 +12,18 @@
 #include "dataformats/ComponentRequest.hpp"
 #include "dataformats/TriggerRecordHeaderData.hpp"
 #include "dataformats/Types.hpp"
+#include "dataformats/detail/AtomicBits.hpp"
 
 #include "ers/Issue.hpp"
 
+#include <algorithm>
 #include <bitset>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dunedaq {
@@ -37,6 +43,8 @@ ERS_DECLARE_ISSUE(dataformats,
 
 namespace dataformats {
 
+class TriggerRecordHeaderBuilder;
+
 /**
  * @brief C++ representation of a TriggerRecordHeader, which wraps a flat array that is the TriggerRecordHeader's
  * "actual" form
@@ -62,10 +70,8 @@ public:
     header.num_requested_components = components.size();
     memcpy(m_data_arr, &header, sizeof(header));
 
-    size_t offset = sizeof(header);
-    for (auto const& component : components) {
-      memcpy(static_cast<uint8_t*>(m_data_arr) + offset, &component, sizeof(component)); // NOLINT
-      offset += sizeof(component);
+    if (!components.empty()) {
+      memcpy(components_(), components.data(), components.size() * sizeof(ComponentRequest));
     }
   }
 
@@ -98,7 +104,9 @@ public:
    */
   TriggerRecordHeader(TriggerRecordHeader const& other)
     : TriggerRecordHeader(other.m_data_arr, true)
-  {}
+  {
+    m_components_sorted = other.m_components_sorted;
+  }
   /**
    * @brief TriggerRecordHeader copy assignment operator
    * @param other TriggerRecordHeader to copy
@@ -118,11 +126,35 @@ public:
     }
     m_alloc = true;
     memcpy(m_data_arr, other.m_data_arr, other.get_total_size_bytes());
+    m_components_sorted = other.m_components_sorted;
     return *this;
   }
 
-  TriggerRecordHeader(TriggerRecordHeader&&) = default;            ///< Default move constructor
-  TriggerRecordHeader& operator=(TriggerRecordHeader&&) = default; ///< Default move assignment operator
+  /**
+   * @brief TriggerRecordHeader move constructor
+   * @param other TriggerRecordHeader to move from. It no longer refers to any data array afterwards
+   */
+  TriggerRecordHeader(TriggerRecordHeader&& other) noexcept
+    : m_data_arr(std::exchange(other.m_data_arr, nullptr))
+    , m_alloc(std::exchange(other.m_alloc, false))
+    , m_components_sorted(std::exchange(other.m_components_sorted, false))
+  {}
+  /**
+   * @brief TriggerRecordHeader move assignment operator
+   * @param other TriggerRecordHeader to move from. It no longer refers to any data array afterwards
+   * @return Reference to this TriggerRecordHeader
+   */
+  TriggerRecordHeader& operator=(TriggerRecordHeader&& other) noexcept
+  {
+    if (&other != this) {
+      if (m_alloc)
+        free(m_data_arr);
+      m_data_arr = std::exchange(other.m_data_arr, nullptr);
+      m_alloc = std::exchange(other.m_alloc, false);
+      m_components_sorted = std::exchange(other.m_components_sorted, false);
+    }
+    return *this;
+  }
 
   /**
    * @brief TriggerRecordHeader destructor
@@ -208,6 +240,46 @@ public:
     set_error_bits(bits);
   }
 
+  /**
+   * @brief Get the error_bits header field with an atomic load, for use while other threads update it
+   * @return Bitset generated from the header's error_bits field
+   */
+  std::bitset<32> atomic_get_error_bits() const { return detail::atomic_load_bits(&header_()->error_bits); }
+  /**
+   * @brief Set the designated error bit with an atomic read-modify-write
+   *
+   * Unlike set_error_bit(), concurrent calls from several threads on the same buffer never lose each other's
+   * updates. Plain reads and writes of error_bits must not run concurrently with this.
+   *
+   * @param bit Bit to set
+   * @param value Value (true/false) for the error bit
+   */
+  void atomic_set_error_bit(TriggerRecordErrorBits bit, bool value)
+  {
+    detail::atomic_assign_bit(&header_()->error_bits, static_cast<size_t>(bit), value);
+  }
+  /**
+   * @brief Atomically set the designated error bit and report whether it was already set
+   *
+   * Exactly one of several threads racing to set the same bit gets false, e.g. to decide which one reports it.
+   *
+   * @param bit Bit to set
+   * @return Value of the bit before it was set
+   */
+  bool atomic_test_and_set_error_bit(TriggerRecordErrorBits bit)
+  {
+    return detail::atomic_assign_bit(&header_()->error_bits, static_cast<size_t>(bit), true);
+  }
+  /**
+   * @brief Atomically clear the designated error bit and report whether it was set
+   * @param bit Bit to clear
+   * @return Value of the bit before it was cleared
+   */
+  bool atomic_test_and_clear_error_bit(TriggerRecordErrorBits bit)
+  {
+    return detail::atomic_assign_bit(&header_()->error_bits, static_cast<size_t>(bit), false);
+  }
+
   /**
    * @brief Get the trigger_type field from the data struct
    * @return The trigger_type field from the TriggerRecordHeaderData struct
@@ -267,8 +339,7 @@ public:
     if (idx >= header_()->num_requested_components) {
       throw ComponentRequestIndexError(ERS_HERE, idx, header_()->num_requested_components - 1);
     }
-    // Increment header pointer by one to skip header
-    return *(reinterpret_cast<ComponentRequest*>(header_() + 1) + idx); // NOLINT
+    return components_()[idx];
   }
 
   /**
@@ -282,21 +353,127 @@ public:
     if (idx >= header_()->num_requested_components) {
       throw ComponentRequestIndexError(ERS_HERE, idx, header_()->num_requested_components - 1);
     }
-    // Increment header pointer by one to skip header
-    return *(reinterpret_cast<ComponentRequest*>(header_() + 1) + idx); // NOLINT
+    // The caller may change the GeoID, so we can no longer rely on the ordering
+    m_components_sorted = false;
+    return components_()[idx];
+  }
+
+  /**
+   * @brief Access a ComponentRequest by index, without range checks
+   *
+   * For loops over indices known to be below get_num_requested_components(). Debug builds assert that idx is valid.
+   *
+   * @param idx Index to access
+   * @return ComponentRequest reference
+   */
+  const ComponentRequest& get_component_unchecked(size_t idx) const noexcept
+  {
+    assert(idx < header_()->num_requested_components);
+    return components_()[idx];
+  }
+  /**
+   * @brief Copy a ComponentRequest by index, reporting an invalid index instead of throwing
+   * @param idx Index to access
+   * @param component Set to the ComponentRequest at idx if idx is valid
+   * @return Whether idx is valid
+   */
+  bool try_get_component(size_t idx, ComponentRequest& component) const noexcept
+  {
+    if (idx >= header_()->num_requested_components) {
+      return false;
+    }
+    component = components_()[idx];
+    return true;
+  }
+
+  /**
+   * @brief Get an iterator to the first ComponentRequest
+   * @return Pointer to the first element of the contiguous ComponentRequest array
+   */
+  const ComponentRequest* begin() const { return components_(); }
+  /**
+   * @brief Get an iterator past the last ComponentRequest
+   * @return Pointer past the last element of the contiguous ComponentRequest array
+   */
+  const ComponentRequest* end() const { return components_() + header_()->num_requested_components; }
+
+  /**
+   * @brief Sort the ComponentRequests by GeoID, so that find() can use a binary search
+   *
+   * The ordering is not part of the TriggerRecordHeader data array, so it has to be re-established (which is
+   * O(n) for an already-sorted array) after reading a TriggerRecordHeader from an existing buffer, or after
+   * modifying components through operator[].
+   */
+  void sort_components()
+  {
+    auto by_component = [](const ComponentRequest& a, const ComponentRequest& b) { return a.component < b.component; };
+    auto components = components_();
+    auto num_components = header_()->num_requested_components;
+    if (!std::is_sorted(components, components + num_components, by_component)) {
+      std::sort(components, components + num_components, by_component);
+    }
+    m_components_sorted = true;
+  }
+  /**
+   * @brief Whether the ComponentRequests are known to be sorted by GeoID
+   * @return True if sort_components() was called and no component was modified since
+   */
+  bool are_components_sorted() const { return m_components_sorted; }
+
+  /**
+   * @brief Find the ComponentRequest for the given GeoID
+   * @param component GeoID to look for
+   * @return Pointer to the (first) matching ComponentRequest, or end() if there is none
+   *
+   * This is a binary search if the components are sorted (see sort_components()), and a linear search otherwise
+   */
+  const ComponentRequest* find(const GeoID& component) const
+  {
+    if (m_components_sorted) {
+      auto it = std::lower_bound(
+        begin(), end(), component, [](const ComponentRequest& cr, const GeoID& id) { return cr.component < id; });
+      return (it != end() && it->component == component) ? it : end();
+    }
+    return std::find_if(begin(), end(), [&](const ComponentRequest& cr) { return cr.component == component; });
   }
 
 private:
+  friend class TriggerRecordHeaderBuilder;
+
+  /**
+   * @brief Tag type selecting the constructor that takes ownership of a malloc'ed data array
+   */
+  struct TakeOverBuffer
+  {};
+  /**
+   * @brief Construct a TriggerRecordHeader which takes ownership of the given data array
+   * @param buffer malloc'ed TriggerRecordHeader data array, freed by this TriggerRecordHeader
+   */
+  TriggerRecordHeader(void* buffer, TakeOverBuffer)
+    : m_data_arr(buffer)
+    , m_alloc(true)
+  {}
+
   /**
    * @brief Get the TriggerRecordHeaderData from the m_data_arr array
    * @return Pointer to the TriggerRecordHeaderData
    */
   TriggerRecordHeaderData* header_() const { return static_cast<TriggerRecordHeaderData*>(m_data_arr); }
+  /**
+   * @brief Get the ComponentRequest array from the m_data_arr array
+   * @return Pointer to the first ComponentRequest
+   */
+  ComponentRequest* components_() const
+  {
+    // Increment header pointer by one to skip header
+    return reinterpret_cast<ComponentRequest*>(header_() + 1); // NOLINT
+  }
 
   void* m_data_arr{
     nullptr
   };                     ///< Flat memory containing a TriggerRecordHeaderData header and an array of ComponentRequests
   bool m_alloc{ false }; ///< Whether the TriggerRecordHeader owns the memory pointed by m_data_arr
+  bool m_components_sorted{ false }; ///< Whether the ComponentRequests are known to be sorted by GeoID
 };
 
 } // namespace dataformats
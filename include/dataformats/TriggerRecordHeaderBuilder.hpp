@@ -0,0 +1,245 @@
+/**
+ * @file TriggerRecordHeaderBuilder.hpp  TriggerRecordHeaderBuilder class definition
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_TRIGGERRECORDHEADERBUILDER_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_TRIGGERRECORDHEADERBUILDER_HPP_
+
+#include "dataformats/ComponentRequest.hpp"
+#include "dataformats/TriggerRecordHeader.hpp"
+#include "dataformats/TriggerRecordHeaderData.hpp"
+#include "dataformats/Types.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Assembles a TriggerRecordHeader by writing ComponentRequests directly into its flat data array
+ *
+ * The data array grows as needed, but reserving the expected number of components up front means it is
+ * allocated exactly once. build() fills in num_requested_components and hands the array over to the
+ * resulting TriggerRecordHeader without copying it.
+ */
+class TriggerRecordHeaderBuilder
+{
+public:
+  /**
+   * @brief Construct a TriggerRecordHeaderBuilder
+   * @param capacity Number of ComponentRequests to reserve space for
+   */
+  explicit TriggerRecordHeaderBuilder(size_t capacity = 0) { reserve(capacity); }
+
+  TriggerRecordHeaderBuilder(TriggerRecordHeaderBuilder const&) = delete; ///< Builders are not copy-constructible
+  TriggerRecordHeaderBuilder& operator=(TriggerRecordHeaderBuilder const&) = delete; ///< Not copy-assignable
+
+  /**
+   * @brief TriggerRecordHeaderBuilder move constructor
+   * @param other TriggerRecordHeaderBuilder to move from. It is left empty
+   */
+  TriggerRecordHeaderBuilder(TriggerRecordHeaderBuilder&& other) noexcept
+    : m_data_arr(std::exchange(other.m_data_arr, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_capacity(std::exchange(other.m_capacity, 0))
+  {}
+  /**
+   * @brief TriggerRecordHeaderBuilder move assignment operator
+   * @param other TriggerRecordHeaderBuilder to move from. It is left empty
+   * @return Reference to this TriggerRecordHeaderBuilder
+   */
+  TriggerRecordHeaderBuilder& operator=(TriggerRecordHeaderBuilder&& other) noexcept
+  {
+    if (&other != this) {
+      free(m_data_arr);
+      m_data_arr = std::exchange(other.m_data_arr, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+      m_capacity = std::exchange(other.m_capacity, 0);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief TriggerRecordHeaderBuilder destructor, frees the data array if build() was not called
+   */
+  ~TriggerRecordHeaderBuilder() { free(m_data_arr); }
+
+  /**
+   * @brief Make sure that the data array can hold at least the given number of ComponentRequests
+   * @param capacity Number of ComponentRequests to reserve space for
+   * @throws MemoryAllocationFailed if the data array cannot be (re)allocated
+   */
+  void reserve(size_t capacity) { free(grow_(capacity)); }
+
+  /**
+   * @brief Construct a ComponentRequest in place at the end of the data array
+   * @param args Arguments forwarded to the ComponentRequest constructor. They may refer to ComponentRequests of
+   * this builder
+   * @return Reference to the new ComponentRequest, valid until the data array next grows
+   */
+  template<typename... Args>
+  ComponentRequest& emplace_back(Args&&... args)
+  {
+    old_data_arr_t old_data_arr(m_size == m_capacity ? grow_(m_capacity == 0 ? 1 : 2 * m_capacity) : nullptr, &free);
+    auto component = new (components_() + m_size) ComponentRequest(std::forward<Args>(args)...);
+    ++m_size;
+    return *component;
+  }
+
+  /**
+   * @brief Copy a ComponentRequest to the end of the data array
+   * @param component ComponentRequest to copy, which may be one of this builder's
+   */
+  void push_back(ComponentRequest const& component) { emplace_back(component); }
+
+  /**
+   * @brief Copy a contiguous array of ComponentRequests to the end of the data array with a single memcpy
+   * @param components Pointer to the first ComponentRequest to copy, which may be one of this builder's
+   * @param count Number of ComponentRequests to copy
+   */
+  void append(const ComponentRequest* components, size_t count)
+  {
+    old_data_arr_t old_data_arr(grow_(m_size + count), &free);
+    if (count > 0) {
+      memcpy(components_() + m_size, components, count * sizeof(ComponentRequest));
+      m_size += count;
+    }
+  }
+
+  /**
+   * @brief Copy a range of ComponentRequests to the end of the data array
+   * @param first Iterator to the first ComponentRequest to copy. The range may be within this builder
+   * @param last Iterator past the last ComponentRequest to copy
+   */
+  template<typename InputIt>
+  void append(InputIt first, InputIt last)
+  {
+    using category_t = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category_t>) {
+      old_data_arr_t old_data_arr(grow_(m_size + std::distance(first, last)), &free);
+      auto end = std::uninitialized_copy(first, last, components_() + m_size);
+      m_size = end - components_();
+    } else {
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    }
+  }
+
+  /**
+   * @brief Set the TriggerRecordHeaderData of the TriggerRecordHeader being built
+   * @param header Header fields to copy, except num_requested_components, which build() sets
+   */
+  void set_header(TriggerRecordHeaderData const& header)
+  {
+    reserve(0);
+    memcpy(m_data_arr, &header, sizeof(header));
+  }
+
+  /**
+   * @brief Get the number of ComponentRequests added so far
+   * @return Number of ComponentRequests in the data array
+   */
+  size_t size() const { return m_size; }
+  /**
+   * @brief Get the number of ComponentRequests the data array can hold without growing
+   * @return Capacity of the data array, in ComponentRequests
+   */
+  size_t capacity() const { return m_capacity; }
+
+  /**
+   * @brief Access a ComponentRequest that was already added
+   * @param idx Index of the ComponentRequest
+   * @return ComponentRequest reference
+   * @throws ComponentRequestIndexError exception if idx is outside of allowable range
+   */
+  ComponentRequest& operator[](size_t idx)
+  {
+    if (idx >= m_size) {
+      throw ComponentRequestIndexError(ERS_HERE, idx, m_size - 1);
+    }
+    return components_()[idx];
+  }
+
+  /**
+   * @brief Finalize the TriggerRecordHeader
+   * @param sort_components Whether to sort the ComponentRequests by GeoID, enabling binary search in
+   * TriggerRecordHeader::find()
+   * @return TriggerRecordHeader owning the data array that was built. The builder is left empty
+   */
+  TriggerRecordHeader build(bool sort_components = false)
+  {
+    reserve(0);
+    static_cast<TriggerRecordHeaderData*>(m_data_arr)->num_requested_components = m_size;
+    m_size = 0;
+    m_capacity = 0;
+    TriggerRecordHeader header(std::exchange(m_data_arr, nullptr), TriggerRecordHeader::TakeOverBuffer());
+    if (sort_components) {
+      header.sort_components();
+    }
+    return header;
+  }
+
+private:
+  /// Data array replaced by grow_(), freed once the arguments that may point into it have been read
+  using old_data_arr_t = std::unique_ptr<void, decltype(&free)>;
+
+  /**
+   * @brief Move the data array to a new allocation with room for at least the given number of ComponentRequests
+   *
+   * As for std::vector, the old array is only freed by the caller, after reading arguments that may point into it.
+   *
+   * @param capacity Number of ComponentRequests to make room for
+   * @return The previous data array, or nullptr if it did not need to grow
+   * @throws MemoryAllocationFailed if the data array cannot be allocated
+   */
+  void* grow_(size_t capacity)
+  {
+    if (m_data_arr != nullptr && capacity <= m_capacity) {
+      return nullptr;
+    }
+
+    size_t size = sizeof(TriggerRecordHeaderData) + capacity * sizeof(ComponentRequest);
+    void* new_data_arr = malloc(size);
+    if (new_data_arr == nullptr) {
+      throw MemoryAllocationFailed(ERS_HERE, size);
+    }
+    if (m_data_arr == nullptr) {
+      TriggerRecordHeaderData header;
+      memcpy(new_data_arr, &header, sizeof(header));
+    } else {
+      memcpy(new_data_arr, m_data_arr, sizeof(TriggerRecordHeaderData) + m_size * sizeof(ComponentRequest));
+    }
+    m_capacity = capacity;
+    return std::exchange(m_data_arr, new_data_arr);
+  }
+
+  /**
+   * @brief Get a pointer to the first ComponentRequest in the data array
+   * @return Pointer to the ComponentRequest array following the TriggerRecordHeaderData
+   */
+  ComponentRequest* components_() const
+  {
+    // Increment header pointer by one to skip header
+    return reinterpret_cast<ComponentRequest*>(static_cast<TriggerRecordHeaderData*>(m_data_arr) + 1); // NOLINT
+  }
+
+  void* m_data_arr{ nullptr }; ///< Flat memory containing a TriggerRecordHeaderData header and ComponentRequests
+  size_t m_size{ 0 };          ///< Number of ComponentRequests stored in m_data_arr
+  size_t m_capacity{ 0 };      ///< Number of ComponentRequests m_data_arr has room for
+};
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_TRIGGERRECORDHEADERBUILDER_HPP_
@@ -10,11 +10,15 @@
 #define DATAFORMATS_INCLUDE_DATAFORMATS_TRIGGERRECORDHEADERDATA_HPP_
 
 #include "dataformats/ComponentRequest.hpp"
+#include "dataformats/FieldTable.hpp"
+#include "dataformats/TextCodec.hpp"
 #include "dataformats/Types.hpp"
 
+#include <charconv>
 #include <limits>
 #include <ostream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace dunedaq {
@@ -182,6 +186,26 @@ operator>>(std::istream& o, TriggerRecordHeaderData& hdr)
          tmp >> hdr.sequence_number >> tmp >> tmp >> hdr.max_sequence_number;
 }
 
+/**
+ * @brief Fields of a TriggerRecordHeaderData, in the order of its stream format
+ */
+template<>
+struct FieldTable<TriggerRecordHeaderData>
+{
+  /// FieldDescriptors of the TriggerRecordHeaderData fields
+  static constexpr auto fields = std::make_tuple(
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, trigger_record_header_marker, "check_word", FieldFormat::kHex),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, version, "version"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, trigger_number, "trigger_number"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, run_number, "run_number"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, trigger_timestamp, "trigger_timestamp"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, trigger_type, "trigger_type"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, error_bits, "error_bits"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, num_requested_components, "num_requested_components"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, sequence_number, "sequence_number"),
+    DATAFORMATS_FIELD(TriggerRecordHeaderData, max_sequence_number, "max_sequence_number"));
+};
+
 } // namespace dataformats
 } // namespace dunedaq
 
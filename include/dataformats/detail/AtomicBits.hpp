@@ -0,0 +1,55 @@
+/**
+ * @file AtomicBits.hpp  Atomic bit operations on header fields stored in Fragment and TriggerRecordHeader buffers
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_DETAIL_ATOMICBITS_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_DETAIL_ATOMICBITS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dunedaq {
+namespace dataformats {
+namespace detail {
+
+// The error_bits fields live inside serialized buffers, not in std::atomic objects, so these use the GCC/Clang
+// __atomic builtins (the C++17 counterpart of std::atomic_ref). The fields are naturally aligned 32-bit words
+// in every header layout, which the builtins require.
+static_assert(__atomic_always_lock_free(sizeof(uint32_t), nullptr), "32-bit atomics must be lock-free"); // NOLINT
+
+/**
+ * @brief Atomically read a 32-bit word
+ * @param word Word to read
+ * @return Value of the word
+ */
+inline uint32_t                                       // NOLINT(build/unsigned)
+atomic_load_bits(const uint32_t* word) noexcept       // NOLINT(build/unsigned)
+{
+  return __atomic_load_n(word, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Atomically set or clear one bit of a 32-bit word
+ * @param word Word to modify
+ * @param bit Index of the bit
+ * @param value Whether to set (true) or clear (false) the bit
+ * @return Whether the bit was set before the update
+ */
+inline bool
+atomic_assign_bit(uint32_t* word, size_t bit, bool value) noexcept // NOLINT(build/unsigned)
+{
+  const uint32_t mask = uint32_t(1) << bit; // NOLINT(build/unsigned)
+  uint32_t previous = value ? __atomic_fetch_or(word, mask, __ATOMIC_ACQ_REL)   // NOLINT(build/unsigned)
+                            : __atomic_fetch_and(word, ~mask, __ATOMIC_ACQ_REL);
+  return (previous & mask) != 0;
+}
+
+} // namespace detail
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_DETAIL_ATOMICBITS_HPP_
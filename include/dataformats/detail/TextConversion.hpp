@@ -0,0 +1,309 @@
+/**
+ * @file TextConversion.hpp  Helpers for the to_chars/from_chars functions of the dataformats structs
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_DETAIL_TEXTCONVERSION_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_DETAIL_TEXTCONVERSION_HPP_
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+
+namespace dunedaq {
+namespace dataformats {
+namespace detail {
+
+/**
+ * @brief Pairs of decimal digits "00" to "99", for writing two digits at a time
+ */
+constexpr char s_digit_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                 "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                 "8081828384858687888990919293949596979899";
+
+/**
+ * @brief Write exactly two decimal digits
+ * @param out Buffer with room for 2 characters
+ * @param value Value below 100
+ */
+inline void
+write_two_digits(char* out, uint32_t value) noexcept // NOLINT(build/unsigned)
+{
+  memcpy(out, s_digit_pairs + 2 * value, 2);
+}
+
+/**
+ * @brief Write exactly eight decimal digits, with leading zeros
+ * @param out Buffer with room for 8 characters
+ * @param value Value below 10^8
+ * @return Pointer past the written digits
+ */
+inline char*
+write_eight_digits(char* out, uint32_t value) noexcept // NOLINT(build/unsigned)
+{
+  uint32_t high = value / 10000; // NOLINT(build/unsigned)
+  uint32_t low = value % 10000;  // NOLINT(build/unsigned)
+  write_two_digits(out, high / 100);
+  write_two_digits(out + 2, high % 100);
+  write_two_digits(out + 4, low / 100);
+  write_two_digits(out + 6, low % 100);
+  return out + 8;
+}
+
+/**
+ * @brief Write a value below 10^8 in decimal, without leading zeros
+ * @param out Buffer with room for 8 characters
+ * @param value Value below 10^8
+ * @return Pointer past the written digits
+ */
+inline char*
+write_up_to_eight_digits(char* out, uint32_t value) noexcept // NOLINT(build/unsigned)
+{
+  int digits = value < 10 ? 1 : value < 100 ? 2 : value < 1000 ? 3 : value < 10000 ? 4 : value < 100000 ? 5
+             : value < 1000000 ? 6 : value < 10000000 ? 7 : 8;
+  char* end = out + digits;
+  char* pos = end;
+  while (value >= 100) {
+    pos -= 2;
+    write_two_digits(pos, value % 100);
+    value /= 100;
+  }
+  if (value >= 10) {
+    write_two_digits(pos - 2, value);
+  } else {
+    *(pos - 1) = static_cast<char>('0' + value);
+  }
+  return end;
+}
+
+/**
+ * @brief Write an unsigned integer in decimal, as std::to_chars does but splitting it into 8-digit blocks that
+ * are formatted with 32-bit arithmetic
+ * @param out Buffer with room for 20 characters
+ * @param value Value to write
+ * @return Pointer past the written digits
+ */
+inline char*
+write_decimal(char* out, uint64_t value) noexcept // NOLINT(build/unsigned)
+{
+  constexpr uint64_t block = 100000000; // NOLINT(build/unsigned)
+  if (value < block) {
+    return write_up_to_eight_digits(out, static_cast<uint32_t>(value)); // NOLINT(build/unsigned)
+  }
+  uint64_t high = value / block;                    // NOLINT(build/unsigned)
+  auto low = static_cast<uint32_t>(value % block); // NOLINT(build/unsigned)
+  if (high < block) {
+    out = write_up_to_eight_digits(out, static_cast<uint32_t>(high)); // NOLINT(build/unsigned)
+  } else {
+    out = write_up_to_eight_digits(out, static_cast<uint32_t>(high / block)); // NOLINT(build/unsigned)
+    out = write_eight_digits(out, static_cast<uint32_t>(high % block));       // NOLINT(build/unsigned)
+  }
+  return write_eight_digits(out, low);
+}
+
+/**
+ * @brief Writes text into a caller-provided buffer, remembering whether it ran out of space
+ *
+ * Once a write does not fit, all further writes are ignored and result() reports
+ * std::errc::value_too_large, as std::to_chars does.
+ */
+class TextWriter
+{
+public:
+  /**
+   * @brief Construct a TextWriter
+   * @param first Start of the buffer
+   * @param last End of the buffer
+   */
+  TextWriter(char* first, char* last) noexcept
+    : m_ptr(first)
+    , m_last(last)
+  {}
+
+  /**
+   * @brief Write a fixed piece of text
+   * @param text Text to write
+   * @return Reference to this TextWriter
+   */
+  TextWriter& literal(std::string_view text) noexcept
+  {
+    if (m_ec == std::errc() && static_cast<size_t>(m_last - m_ptr) >= text.size()) {
+      memcpy(m_ptr, text.data(), text.size());
+      m_ptr += text.size();
+    } else {
+      m_ec = std::errc::value_too_large;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Write an integer
+   * @param value Integer to write
+   * @param base Base to write the integer in
+   * @return Reference to this TextWriter
+   */
+  template<typename T>
+  TextWriter& number(T value, int base = 10) noexcept
+  {
+    if (m_ec == std::errc()) {
+      update_(std::to_chars(m_ptr, m_last, value, base));
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Write a dataformats struct using its to_chars function
+   * @param value Struct to write
+   * @return Reference to this TextWriter
+   */
+  template<typename T>
+  TextWriter& object(const T& value) noexcept
+  {
+    if (m_ec == std::errc()) {
+      update_(to_chars(m_ptr, m_last, value));
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Get the outcome of the writes
+   * @return Pointer past the written text, or m_last and std::errc::value_too_large if it did not fit
+   */
+  std::to_chars_result result() const noexcept
+  {
+    return m_ec == std::errc() ? std::to_chars_result{ m_ptr, m_ec } : std::to_chars_result{ m_last, m_ec };
+  }
+
+private:
+  void update_(std::to_chars_result res) noexcept
+  {
+    m_ptr = res.ptr;
+    m_ec = res.ec;
+  }
+
+  char* m_ptr;              ///< Next character to write
+  char* m_last;             ///< End of the buffer
+  std::errc m_ec{};         ///< First error encountered
+};
+
+/**
+ * @brief Reads text in the format written by the dataformats stream operators
+ *
+ * The stream operators read field labels and separators as whitespace-delimited tokens which are discarded,
+ * and this reader does the same, so that it reads what operator<< writes as operator>> does. Once a read fails,
+ * all further reads are ignored and result() reports the first error, pointing at the start of the text as
+ * std::from_chars does.
+ */
+class TextReader
+{
+public:
+  /**
+   * @brief Construct a TextReader
+   * @param first Start of the text
+   * @param last End of the text
+   */
+  TextReader(const char* first, const char* last) noexcept
+    : m_first(first)
+    , m_ptr(first)
+    , m_last(last)
+  {}
+
+  /**
+   * @brief Read the next whitespace-delimited token
+   * @return The token, or an empty view if there is none
+   */
+  std::string_view token() noexcept
+  {
+    if (m_ec != std::errc()) {
+      return {};
+    }
+    skip_whitespace_();
+    const char* start = m_ptr;
+    while (m_ptr != m_last && !is_whitespace_(*m_ptr)) {
+      ++m_ptr;
+    }
+    if (m_ptr == start) {
+      m_ec = std::errc::invalid_argument;
+    }
+    return std::string_view(start, m_ptr - start);
+  }
+  /**
+   * @brief Discard the next whitespace-delimited token, e.g. a field label
+   * @return Reference to this TextReader
+   */
+  TextReader& skip_token() noexcept
+  {
+    token();
+    return *this;
+  }
+
+  /**
+   * @brief Read an integer, skipping leading whitespace
+   * @param value Integer to fill
+   * @param base Base the integer is written in
+   * @return Reference to this TextReader
+   */
+  template<typename T>
+  TextReader& number(T& value, int base = 10) noexcept
+  {
+    if (m_ec == std::errc()) {
+      skip_whitespace_();
+      update_(std::from_chars(m_ptr, m_last, value, base));
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Read a dataformats struct using its from_chars function, skipping leading whitespace
+   * @param value Struct to fill
+   * @return Reference to this TextReader
+   */
+  template<typename T>
+  TextReader& object(T& value) noexcept
+  {
+    if (m_ec == std::errc()) {
+      skip_whitespace_();
+      update_(from_chars(m_ptr, m_last, value));
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Get the outcome of the reads
+   * @return Pointer past the text that was read, or the start of the text and the first error
+   */
+  std::from_chars_result result() const noexcept
+  {
+    return m_ec == std::errc() ? std::from_chars_result{ m_ptr, m_ec } : std::from_chars_result{ m_first, m_ec };
+  }
+
+private:
+  static bool is_whitespace_(char c) noexcept { return c == ' ' || (c >= '\t' && c <= '\r'); }
+  void skip_whitespace_() noexcept
+  {
+    while (m_ptr != m_last && is_whitespace_(*m_ptr)) {
+      ++m_ptr;
+    }
+  }
+  void update_(std::from_chars_result res) noexcept
+  {
+    m_ptr = res.ptr;
+    m_ec = res.ec;
+  }
+
+  const char* m_first;      ///< Start of the text
+  const char* m_ptr;        ///< Next character to read
+  const char* m_last;       ///< End of the text
+  std::errc m_ec{};         ///< First error encountered
+};
+
+} // namespace detail
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_DETAIL_TEXTCONVERSION_HPP_
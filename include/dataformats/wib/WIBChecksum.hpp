@@ -0,0 +1,149 @@
+/**
+ * @file WIBChecksum.hpp Computation and verification of the COLDATA checksums of WIB1 frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBCHECKSUM_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBCHECKSUM_HPP_
+
+#include "dataformats/wib/WIBFrame.hpp"
+#include "dataformats/wib/WIBLinkID.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace dunedaq::dataformats::wib {
+
+/**
+ * @brief The two checksums of a ColdataBlock
+ *
+ * Each COLDATA chip sends two byte streams, interleaved byte by byte in the ColdataSegments: stream A in the
+ * even bytes (even ADCs) and stream B in the odd bytes (odd ADCs). Each checksum is taken to be the plain sum of
+ * the 48 data bytes of its stream, at most 48 * 255 = 12240, so it never wraps in the 16-bit header field; the
+ * ColdataHeader itself is not included.
+ *
+ * This definition is provisional: it has not been checked against the COLDATA specification or against frames
+ * from real hardware. Until it is, a mismatch reported by verify_coldata_checksums() may come from the
+ * definition rather than from the data.
+ */
+struct ColdataChecksums
+{
+  uint16_t a{ 0 }; ///< Checksum of stream A // NOLINT(build/unsigned)
+  uint16_t b{ 0 }; ///< Checksum of stream B // NOLINT(build/unsigned)
+
+  /**
+   * @brief Comparison operator (to allow ColdataChecksums comparisons)
+   */
+  bool operator==(const ColdataChecksums& other) const noexcept { return a == other.a && b == other.b; }
+  /**
+   * @brief Comparison operator (to allow ColdataChecksums comparisons)
+   */
+  bool operator!=(const ColdataChecksums& other) const noexcept { return !(*this == other); }
+};
+
+/**
+ * @brief Compute the checksums of the data in a ColdataBlock
+ * @param block Block whose segments to sum
+ * @return Checksums of the two streams
+ */
+ColdataChecksums
+compute_coldata_checksums(const ColdataBlock& block) noexcept;
+
+/**
+ * @brief Check the checksums in the ColdataHeaders of a frame against its data
+ *
+ * The checksums are recomputed with compute_coldata_checksums(), whose definition is provisional (see
+ * ColdataChecksums), so mismatches on frames from hardware are not yet proof of corruption.
+ *
+ * @param frame Frame to check
+ * @return Bit mask of the checksums that do not match: bit 2 * block for stream A of a block, bit 2 * block + 1
+ * for stream B. Zero if the frame is intact
+ */
+uint8_t // NOLINT(build/unsigned)
+verify_coldata_checksums(const WIBFrame& frame) noexcept;
+
+/**
+ * @brief Write the checksums of their data into the ColdataHeaders of consecutive frames, e.g. in emulators
+ * @param frames First frame
+ * @param num_frames Number of frames
+ */
+void
+fill_coldata_checksums(WIBFrame* frames, size_t num_frames) noexcept;
+
+/**
+ * @brief Checksum mismatch counts of one link
+ */
+struct ColdataChecksumCounts
+{
+  uint64_t num_frames{ 0 };     ///< Frames checked // NOLINT(build/unsigned)
+  uint64_t num_bad_frames{ 0 }; ///< Frames with at least one mismatch // NOLINT(build/unsigned)
+  uint64_t num_bad_a{ 0 };      ///< Stream A checksums that do not match // NOLINT(build/unsigned)
+  uint64_t num_bad_b{ 0 };      ///< Stream B checksums that do not match // NOLINT(build/unsigned)
+
+  /**
+   * @brief Add the counts of another ColdataChecksumCounts to these
+   * @param other Counts to add
+   */
+  void merge(const ColdataChecksumCounts& other) noexcept
+  {
+    num_frames += other.num_frames;
+    num_bad_frames += other.num_bad_frames;
+    num_bad_a += other.num_bad_a;
+    num_bad_b += other.num_bad_b;
+  }
+};
+
+/**
+ * @brief Checksum mismatch counts over many frames, per link
+ *
+ * Each thread can fill its own instance, to be combined with merge().
+ */
+class ColdataChecksumSummary
+{
+public:
+  /**
+   * @brief Verify the checksums of consecutive frames and count the mismatches per link
+   * @param frames First frame
+   * @param num_frames Number of frames
+   * @return Number of frames with at least one mismatch
+   */
+  size_t add(const WIBFrame* frames, size_t num_frames);
+
+  /**
+   * @brief Add the counts of another summary to this one
+   * @param other Summary to add
+   */
+  void merge(const ColdataChecksumSummary& other);
+
+  /**
+   * @brief Remove all counts
+   */
+  void clear() noexcept { m_links.clear(); }
+
+  /**
+   * @brief Get the counts of every link seen, ordered by crate, slot and fiber
+   */
+  const std::map<WIBLinkID, ColdataChecksumCounts>& get_links() const noexcept { return m_links; }
+
+  /**
+   * @brief Get the counts of one link
+   * @param link Link to look up
+   * @return Its counts, all zero if no frame of the link was added
+   */
+  ColdataChecksumCounts get_counts(const WIBLinkID& link) const;
+
+  /**
+   * @brief Get the counts summed over all links
+   */
+  ColdataChecksumCounts get_total() const;
+
+private:
+  std::map<WIBLinkID, ColdataChecksumCounts> m_links;
+};
+
+} // namespace dunedaq::dataformats::wib
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBCHECKSUM_HPP_
@@ -0,0 +1,124 @@
+/**
+ * @file WIBErrorScan.hpp Counting of the error fields in the headers of WIB1 frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBERRORSCAN_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBERRORSCAN_HPP_
+
+#include "dataformats/Fragment.hpp"
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/wib/WIBFrame.hpp"
+#include "dataformats/wib/WIBLinkID.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace dunedaq::dataformats::wib {
+
+/**
+ * @brief Error counts of the WIB and COLDATA headers of one link
+ *
+ * Frame-level counts say how many frames had a field set; block-level counts how many ColdataBlocks did. The
+ * *_or fields are the OR of every value seen, to tell which error bits occurred.
+ */
+struct WIBErrorCounts
+{
+  uint64_t num_frames{ 0 };             ///< Frames scanned // NOLINT(build/unsigned)
+  uint64_t num_frames_with_errors{ 0 }; ///< Frames with any error field set // NOLINT(build/unsigned)
+  uint64_t num_mm{ 0 };                 ///< Frames with WIBHeader::mm set // NOLINT(build/unsigned)
+  uint64_t num_oos{ 0 };                ///< Frames with WIBHeader::oos set // NOLINT(build/unsigned)
+  uint64_t num_wib_errors{ 0 };         ///< Frames with a non-zero WIBHeader::wib_errors // NOLINT(build/unsigned)
+  uint64_t num_s1_errors{ 0 };          ///< Blocks with a non-zero ColdataHeader::s1_error // NOLINT(build/unsigned)
+  uint64_t num_s2_errors{ 0 };          ///< Blocks with a non-zero ColdataHeader::s2_error // NOLINT(build/unsigned)
+  uint64_t num_error_registers{ 0 };    ///< Blocks with a non-zero ColdataHeader::error_register // NOLINT
+  uint16_t wib_errors_or{ 0 };          ///< OR of all WIBHeader::wib_errors // NOLINT(build/unsigned)
+  uint16_t error_register_or{ 0 };      ///< OR of all ColdataHeader::error_register // NOLINT(build/unsigned)
+  uint8_t s1_error_or{ 0 };             ///< OR of all ColdataHeader::s1_error // NOLINT(build/unsigned)
+  uint8_t s2_error_or{ 0 };             ///< OR of all ColdataHeader::s2_error // NOLINT(build/unsigned)
+
+  /**
+   * @brief Count the error fields of one frame
+   * @param frame Frame to count
+   * @return Whether the frame has any error field set
+   */
+  bool add(const WIBFrame& frame) noexcept;
+
+  /**
+   * @brief Add the counts of another WIBErrorCounts to these
+   * @param other Counts to add
+   */
+  void merge(const WIBErrorCounts& other) noexcept;
+};
+
+/**
+ * @brief Error counts of WIB frames, per link
+ *
+ * Intended as an always-on health indicator: frames are checked in blocks by OR-ing their masked header words,
+ * and only blocks with an error field set are looked at frame by frame. Each thread can fill its own instance, to
+ * be combined with merge().
+ */
+class WIBErrorSummary
+{
+public:
+  /**
+   * @brief Count the error fields of consecutive frames
+   * @param frames First frame
+   * @param num_frames Number of frames
+   * @return Number of frames with any error field set
+   */
+  size_t add(const WIBFrame* frames, size_t num_frames);
+
+  /**
+   * @brief Count the error fields of the WIBFrames in a Fragment payload; a partial frame at the end is ignored
+   * @param fragment Fragment whose payload is an array of WIBFrame
+   * @return Number of frames with any error field set
+   */
+  size_t add(const Fragment& fragment);
+
+  /**
+   * @brief Count the error fields of the WIBFrames in a Fragment payload, and flag the Fragment if any is set
+   * @param fragment Fragment whose payload is an array of WIBFrame
+   * @param error_bit Error bit to set in the Fragment if any frame has an error field set
+   * @return Number of frames with any error field set
+   */
+  size_t add(Fragment& fragment, FragmentErrorBits error_bit);
+
+  /**
+   * @brief Add the counts of another summary to this one
+   * @param other Summary to add
+   */
+  void merge(const WIBErrorSummary& other);
+
+  /**
+   * @brief Remove all counts
+   */
+  void clear() noexcept { m_links.clear(); }
+
+  /**
+   * @brief Get the counts of every link seen, ordered by crate, slot and fiber
+   */
+  const std::map<WIBLinkID, WIBErrorCounts>& get_links() const noexcept { return m_links; }
+
+  /**
+   * @brief Get the counts of one link
+   * @param link Link to look up
+   * @return Its counts, all zero if no frame of the link was added
+   */
+  WIBErrorCounts get_counts(const WIBLinkID& link) const;
+
+  /**
+   * @brief Get the counts summed over all links
+   */
+  WIBErrorCounts get_total() const;
+
+private:
+  std::map<WIBLinkID, WIBErrorCounts> m_links;
+};
+
+} // namespace dunedaq::dataformats::wib
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBERRORSCAN_HPP_
@@ -14,6 +14,8 @@
 #include "ers/Issue.hpp"
 
 #include <bitset>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -232,7 +234,13 @@ struct ColdataSegment
   word_t adc0ch1_2 : 8, adc1ch1_2 : 8, adc0ch2_1 : 8, adc1ch2_1 : 8;
   word_t adc0ch2_2 : 4, adc0ch3_1 : 4, adc1ch2_2 : 4, adc1ch3_1 : 4, adc0ch3_2 : 8, adc1ch3_2 : 8;
 
-  uint16_t get_channel(const uint8_t adc, const uint8_t ch) const // NOLINT(build/unsigned)
+  /**
+   * @brief Get the value of a channel, without range checks
+   * @param adc ADC number; only its parity selects the ADC within the segment
+   * @param ch Channel number; only ch % 4 selects the channel within the segment
+   * @return 12-bit ADC value
+   */
+  constexpr uint16_t get_channel_unchecked(const uint8_t adc, const uint8_t ch) const noexcept // NOLINT(build/unsigned)
   {
     if (adc % 2 == 0) {
       switch (ch % 4) {
@@ -242,22 +250,26 @@ struct ColdataSegment
           return adc0ch1_1 | adc0ch1_2 << 4;
         case 2:
           return adc0ch2_1 | adc0ch2_2 << 8;
-        case 3:
+        default:
           return adc0ch3_1 | adc0ch3_2 << 4;
       }
-    } else if (adc % 2 == 1) {
-      switch (ch % 4) {
-        case 0:
-          return adc1ch0_1 | adc1ch0_2 << 8;
-        case 1:
-          return adc1ch1_1 | adc1ch1_2 << 4;
-        case 2:
-          return adc1ch2_1 | adc1ch2_2 << 8;
-        case 3:
-          return adc1ch3_1 | adc1ch3_2 << 4;
-      }
     }
-    throw WibFrameRelatedIndexError(ERS_HERE, adc, 0, 1);
+    switch (ch % 4) {
+      case 0:
+        return adc1ch0_1 | adc1ch0_2 << 8;
+      case 1:
+        return adc1ch1_1 | adc1ch1_2 << 4;
+      case 2:
+        return adc1ch2_1 | adc1ch2_2 << 8;
+      default:
+        return adc1ch3_1 | adc1ch3_2 << 4;
+    }
+  }
+
+  uint16_t get_channel(const uint8_t adc, const uint8_t ch) const // NOLINT(build/unsigned)
+  {
+    // Every adc and ch value selects a valid field, so there is nothing to check
+    return get_channel_unchecked(adc, ch);
   }
 
   void set_channel(const uint8_t adc, const uint8_t ch, const uint16_t new_val) // NOLINT(build/unsigned)
@@ -322,6 +334,32 @@ struct ColdataBlock
     // Each segment houses one half (four channels) of two subsequent ADCs.
     return segments[get_segment_index_(adc, ch)].get_channel(adc, ch);
   }
+  /**
+   * @brief Get the value of a channel, without range checks. Debug builds assert that the indices are valid
+   * @param adc ADC number, 0 to 7
+   * @param ch Channel number within the ADC, 0 to 7
+   * @return 12-bit ADC value
+   */
+  constexpr uint16_t get_channel_unchecked(const uint8_t adc, const uint8_t ch) const noexcept // NOLINT(build/unsigned)
+  {
+    assert((adc / 2) * 2 + ch / 4 < s_num_seg_per_block);
+    return segments[(adc / 2) * 2 + ch / 4].get_channel_unchecked(adc, ch);
+  }
+  /**
+   * @brief Get the value of a channel, reporting invalid indices instead of throwing
+   * @param adc ADC number, 0 to 7
+   * @param ch Channel number within the ADC, 0 to 7
+   * @param value Set to the 12-bit ADC value if the indices are valid
+   * @return Whether the indices are valid
+   */
+  constexpr bool try_get_channel(const uint8_t adc, const uint8_t ch, uint16_t& value) const noexcept // NOLINT
+  {
+    if ((adc / 2) * 2 + ch / 4 >= s_num_seg_per_block) {
+      return false;
+    }
+    value = get_channel_unchecked(adc, ch);
+    return true;
+  }
 
   void set_channel(const uint8_t adc, const uint8_t ch, const uint16_t new_val) // NOLINT(build/unsigned)
   {
@@ -380,6 +418,11 @@ public:
     throw_if_invalid_block_index_(block_index);
     return &m_blocks[block_index].head;
   }
+  ColdataHeader* get_coldata_header(const unsigned block_index)
+  {
+    throw_if_invalid_block_index_(block_index);
+    return &m_blocks[block_index].head;
+  }
   const ColdataBlock& get_block(const uint8_t b) const // NOLINT(build/unsigned)
   {
     throw_if_invalid_block_index_(b);
@@ -408,6 +451,39 @@ public:
     return get_channel(ch / ColdataBlock::s_num_ch_per_block, ch % ColdataBlock::s_num_ch_per_block);
   }
 
+  // Unchecked ColdataBlock channel accessors, for inner loops over channels whose indices are known to be valid.
+  // They never throw; debug builds assert on invalid indices.
+  constexpr uint16_t get_channel_unchecked(const uint8_t block_num,         // NOLINT(build/unsigned)
+                                           const uint8_t adc,               // NOLINT(build/unsigned)
+                                           const uint8_t ch) const noexcept // NOLINT(build/unsigned)
+  {
+    assert(block_num < s_num_block_per_frame);
+    return m_blocks[block_num].get_channel_unchecked(adc, ch);
+  }
+  constexpr uint16_t get_channel_unchecked(const uint8_t block_num, const uint8_t ch) const noexcept // NOLINT
+  {
+    return get_channel_unchecked(
+      block_num, ch / ColdataBlock::s_num_adc_per_block, ch % ColdataBlock::s_num_adc_per_block);
+  }
+  constexpr uint16_t get_channel_unchecked(const uint8_t ch) const noexcept // NOLINT(build/unsigned)
+  {
+    return get_channel_unchecked(ch / ColdataBlock::s_num_ch_per_block, ch % ColdataBlock::s_num_ch_per_block);
+  }
+
+  // Non-throwing ColdataBlock channel accessors: return false, leaving value unchanged, on invalid indices
+  constexpr bool try_get_channel(const uint8_t block_num,        // NOLINT(build/unsigned)
+                                 const uint8_t adc,              // NOLINT(build/unsigned)
+                                 const uint8_t ch,               // NOLINT(build/unsigned)
+                                 uint16_t& value) const noexcept // NOLINT(build/unsigned)
+  {
+    return block_num < s_num_block_per_frame && m_blocks[block_num].try_get_channel(adc, ch, value);
+  }
+  constexpr bool try_get_channel(const uint8_t block_num, const uint8_t ch, uint16_t& value) const noexcept // NOLINT
+  {
+    return try_get_channel(
+      block_num, ch / ColdataBlock::s_num_adc_per_block, ch % ColdataBlock::s_num_adc_per_block, value);
+  }
+
   // ColdataBlock channel mutators
   void set_channel(const uint8_t block_num, // NOLINT(build/unsigned)
                    const uint8_t adc,       // NOLINT(build/unsigned)
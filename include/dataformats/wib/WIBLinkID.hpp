@@ -0,0 +1,75 @@
+/**
+ * @file WIBLinkID.hpp Identification of the WIB link that sent a WIB1 frame
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBLINKID_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBLINKID_HPP_
+
+#include "dataformats/wib/WIBFrame.hpp"
+
+#include <cstdint>
+#include <ostream>
+
+namespace dunedaq::dataformats::wib {
+
+/**
+ * @brief Crate, slot and fiber of a WIB link, as written in the WIBHeader of its frames
+ */
+struct WIBLinkID
+{
+  uint8_t crate{ 0 }; ///< Crate number // NOLINT(build/unsigned)
+  uint8_t slot{ 0 };  ///< Slot number within the crate // NOLINT(build/unsigned)
+  uint8_t fiber{ 0 }; ///< Fiber number within the WIB // NOLINT(build/unsigned)
+
+  /**
+   * @brief Get a key that orders links by crate, then slot, then fiber
+   */
+  constexpr uint32_t get_key() const noexcept // NOLINT(build/unsigned)
+  {
+    return static_cast<uint32_t>(crate) << 16 | static_cast<uint32_t>(slot) << 8 | fiber; // NOLINT(build/unsigned)
+  }
+
+  /**
+   * @brief Comparison operator (to allow WIBLinkID to be used in std::map)
+   */
+  constexpr bool operator<(const WIBLinkID& other) const noexcept { return get_key() < other.get_key(); }
+  /**
+   * @brief Comparison operator (to allow WIBLinkID comparisons)
+   */
+  constexpr bool operator==(const WIBLinkID& other) const noexcept { return get_key() == other.get_key(); }
+  /**
+   * @brief Comparison operator (to allow WIBLinkID comparisons)
+   */
+  constexpr bool operator!=(const WIBLinkID& other) const noexcept { return get_key() != other.get_key(); }
+};
+
+/**
+ * @brief Get the link that sent a frame
+ * @param header WIBHeader of the frame
+ * @return Crate, slot and fiber of the header
+ */
+inline WIBLinkID
+get_link_id(const WIBHeader& header) noexcept
+{
+  WIBLinkID id;
+  id.crate = header.crate_no;
+  id.slot = header.slot_no;
+  id.fiber = header.fiber_no;
+  return id;
+}
+
+/**
+ * @brief Stream a WIBLinkID in human-readable form
+ */
+inline std::ostream&
+operator<<(std::ostream& o, const WIBLinkID& id)
+{
+  return o << "crate:" << unsigned(id.crate) << " slot:" << unsigned(id.slot) << " fiber:" << unsigned(id.fiber);
+}
+
+} // namespace dunedaq::dataformats::wib
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBLINKID_HPP_
@@ -0,0 +1,142 @@
+/**
+ * @file WIBUnpack.hpp Bulk decoding and encoding of the ADC values of WIB1 frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBUNPACK_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBUNPACK_HPP_
+
+#include "dataformats/wib/WIBFrame.hpp"
+
+#include "ers/Issue.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace dunedaq {
+
+/**
+ * @brief An ERS Error indicating that the requested unpack implementation cannot run on this CPU
+ * @param wui_implementation Name of the requested implementation
+ * @cond Doxygen doesn't like ERS macros LCOV_EXCL_START
+ */
+ERS_DECLARE_ISSUE(dataformats,
+                  WIBUnpackImplementationUnsupported,
+                  "The " << wui_implementation << " WIB unpack implementation is not supported by this CPU",
+                  ((std::string)wui_implementation)) // NOLINT
+                                                     /// @endcond LCOV_EXCL_STOP
+
+namespace dataformats {
+namespace wib {
+
+/**
+ * @brief Instruction sets the WIB unpacker and packer can use
+ */
+enum class UnpackImplementation
+{
+  kScalar, ///< Portable C++
+  kSSSE3,  ///< 128-bit byte shuffles
+  kAVX2    ///< 256-bit byte shuffles
+};
+
+/**
+ * @brief Get the name of an unpack implementation
+ * @param implementation Implementation to name
+ * @return Name of the implementation, e.g. "AVX2"
+ */
+const char*
+get_unpack_implementation_name(UnpackImplementation implementation) noexcept;
+
+/**
+ * @brief Check whether the CPU running the program can use an unpack implementation
+ * @param implementation Implementation to check
+ * @return Whether unpack_frames() and pack_frames() can be called with this implementation
+ */
+bool
+is_unpack_implementation_supported(UnpackImplementation implementation) noexcept;
+
+/**
+ * @brief Get the implementation used by unpack_frames() and pack_frames() when none is given
+ * @return The fastest implementation supported by the CPU, detected on first use
+ */
+UnpackImplementation
+get_best_unpack_implementation() noexcept;
+
+/**
+ * @brief Decode the ADC values of consecutive WIBFrames
+ *
+ * The values of each frame are written in the order of WIBFrame::get_channel(ch), ch = 0 to 255, and are
+ * bit-exact with it.
+ *
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param adcs Output, with room for num_frames * WIBFrame::s_num_ch_per_frame values
+ */
+void
+unpack_frames(const WIBFrame* frames, size_t num_frames, adc_t* adcs) noexcept;
+
+/**
+ * @brief Decode the ADC values of consecutive WIBFrames with a given implementation, e.g. to compare them
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param adcs Output, with room for num_frames * WIBFrame::s_num_ch_per_frame values
+ * @param implementation Implementation to use
+ * @throws WIBUnpackImplementationUnsupported if the CPU does not support the implementation
+ */
+void
+unpack_frames(const WIBFrame* frames, size_t num_frames, adc_t* adcs, UnpackImplementation implementation);
+
+/**
+ * @brief Decode the ADC values of one WIBFrame
+ * @param frame Frame to decode
+ * @param adcs Output, with room for WIBFrame::s_num_ch_per_frame values in get_channel() order
+ */
+inline void
+unpack_frame(const WIBFrame& frame, adc_t* adcs) noexcept
+{
+  unpack_frames(&frame, 1, adcs);
+}
+
+/**
+ * @brief Encode the ADC values of consecutive WIBFrames
+ *
+ * Only the ColdataSegments are written; the WIBHeader and ColdataHeaders are left as they are. Values are taken
+ * in the order of WIBFrame::set_channel(ch, value), ch = 0 to 255, and truncated to 12 bits like it, so that
+ * unpack_frames() returns them unchanged.
+ *
+ * @param adcs Values, num_frames * WIBFrame::s_num_ch_per_frame of them
+ * @param frames First frame to write
+ * @param num_frames Number of frames
+ */
+void
+pack_frames(const adc_t* adcs, WIBFrame* frames, size_t num_frames) noexcept;
+
+/**
+ * @brief Encode the ADC values of consecutive WIBFrames with a given implementation, e.g. to compare them
+ * @param adcs Values, num_frames * WIBFrame::s_num_ch_per_frame of them
+ * @param frames First frame to write
+ * @param num_frames Number of frames
+ * @param implementation Implementation to use
+ * @throws WIBUnpackImplementationUnsupported if the CPU does not support the implementation
+ */
+void
+pack_frames(const adc_t* adcs, WIBFrame* frames, size_t num_frames, UnpackImplementation implementation);
+
+/**
+ * @brief Encode the ADC values of one WIBFrame
+ * @param adcs Values, WIBFrame::s_num_ch_per_frame of them in set_channel() order
+ * @param frame Frame to write
+ */
+inline void
+pack_frame(const adc_t* adcs, WIBFrame& frame) noexcept
+{
+  pack_frames(adcs, &frame, 1);
+}
+
+} // namespace wib
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_WIB_WIBUNPACK_HPP_
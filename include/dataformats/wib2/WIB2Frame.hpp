@@ -93,26 +93,44 @@ public:
   {
     if (i < 0 || i >= s_num_channels)
       throw std::out_of_range("ADC index out of range");
+    return get_adc_unchecked(i);
+  }
 
-    // The index of the first (and sometimes only) word containing the required ADC value
+  /**
+   * @brief Get the ith ADC value in the frame, without range checks
+   *
+   * For inner loops whose indices are known to be valid: it never throws, so it can be inlined and vectorized.
+   * Debug builds assert that i is valid.
+   */
+  constexpr uint16_t get_adc_unchecked(int i) const noexcept // NOLINT(build/unsigned)
+  {
+    assert(i >= 0 && i < s_num_channels);
+    // Read the word holding the lowest bit together with the next one, so that values spanning two words need no
+    // branch. The last word never holds the start of a spanning value, so it is paired with itself
     int word_index = s_bits_per_adc * i / s_bits_per_word;
-    assert(word_index < s_num_adc_words);
-    // Where in the word the lowest bit of our ADC value is located
-    int first_bit_position = (s_bits_per_adc * i) % s_bits_per_word;
-    // How many bits of our desired ADC are located in the `word_index`th word
-    int bits_from_first_word = std::min(s_bits_per_adc, s_bits_per_word - first_bit_position);
-    uint16_t adc = adc_words[word_index] >> first_bit_position; // NOLINT(build/unsigned)
-    // If we didn't get the full 14 bits from this word, we need the rest from the next word
-    if (bits_from_first_word < s_bits_per_adc) {
-      assert(word_index + 1 < s_num_adc_words);
-      adc |= adc_words[word_index + 1] << bits_from_first_word;
+    int next_word_index = std::min(word_index + 1, s_num_adc_words - 1);
+    uint64_t words = adc_words[word_index] |                                          // NOLINT(build/unsigned)
+                     static_cast<uint64_t>(adc_words[next_word_index]) << s_bits_per_word; // NOLINT(build/unsigned)
+    return (words >> ((s_bits_per_adc * i) % s_bits_per_word)) & 0x3FFFu;
+  }
+
+  /**
+   * @brief Get the ith ADC value in the frame, reporting an invalid index instead of throwing
+   * @return Whether i is valid. If it is not, @p value is left unchanged
+   */
+  constexpr bool try_get_adc(int i, uint16_t& value) const noexcept // NOLINT(build/unsigned)
+  {
+    if (i < 0 || i >= s_num_channels) {
+      return false;
     }
-    // Mask out all but the lowest 14 bits;
-    return adc & 0x3FFFu;
+    value = get_adc_unchecked(i);
+    return true;
   }
 
   /**
    * @brief Set the ith ADC value in the frame to @p val
+   *
+   * The bits of the previous value are cleared first, so the frame does not need to be zeroed beforehand
    */
   void set_adc(int i, uint16_t val) // NOLINT(build/unsigned)
   {
@@ -128,10 +146,13 @@ public:
     int first_bit_position = (s_bits_per_adc * i) % s_bits_per_word;
     // How many bits of our desired ADC are located in the `word_index`th word
     int bits_in_first_word = std::min(s_bits_per_adc, s_bits_per_word - first_bit_position);
-    adc_words[word_index] |= (val << first_bit_position);
+    constexpr word_t adc_mask = (word_t(1) << s_bits_per_adc) - 1;
+    adc_words[word_index] &= ~(adc_mask << first_bit_position);
+    adc_words[word_index] |= (static_cast<word_t>(val) << first_bit_position);
     // If we didn't put the full 14 bits in this word, we need to put the rest in the next word
     if (bits_in_first_word < s_bits_per_adc) {
       assert(word_index + 1 < s_num_adc_words);
+      adc_words[word_index + 1] &= ~(adc_mask >> bits_in_first_word);
       adc_words[word_index + 1] |= val >> bits_in_first_word;
     }
   }
@@ -176,6 +197,14 @@ public:
     return (uint64_t)header.timestamp_1 | ((uint64_t)header.timestamp_2 << 32); // NOLINT(build/unsigned)
   }
 
+  /** @brief Set the 64-bit timestamp of the frame
+   */
+  void set_timestamp(const uint64_t new_timestamp) // NOLINT(build/unsigned)
+  {
+    header.timestamp_1 = new_timestamp;
+    header.timestamp_2 = new_timestamp >> 32;
+  }
+
 private:
   enum View
   {
@@ -0,0 +1,168 @@
+/**
+ * @file WIB2Unpack.hpp Bulk decoding and encoding of the ADC values of WIB2 frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+#ifndef DATAFORMATS_INCLUDE_DATAFORMATS_WIB2_WIB2UNPACK_HPP_
+#define DATAFORMATS_INCLUDE_DATAFORMATS_WIB2_WIB2UNPACK_HPP_
+
+#include "dataformats/wib2/WIB2Frame.hpp"
+
+#include "ers/Issue.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dunedaq {
+
+/**
+ * @brief An ERS Error indicating that the requested WIB2 unpack implementation cannot run on this CPU
+ * @param w2ui_implementation Name of the requested implementation
+ * @cond Doxygen doesn't like ERS macros LCOV_EXCL_START
+ */
+ERS_DECLARE_ISSUE(dataformats,
+                  WIB2UnpackImplementationUnsupported,
+                  "The " << w2ui_implementation << " WIB2 unpack implementation is not supported by this CPU",
+                  ((std::string)w2ui_implementation)) // NOLINT
+                                                      /// @endcond LCOV_EXCL_STOP
+
+namespace dataformats {
+namespace wib2 {
+
+/**
+ * @brief Instruction sets the WIB2 unpacker and packer can use
+ */
+enum class UnpackImplementation
+{
+  kScalar,     ///< Portable C++
+  kAVX2,       ///< 256-bit byte shuffles and per-lane shifts
+  kAVX512VBMI  ///< 512-bit byte permutes and bit-field extraction
+};
+
+/**
+ * @brief Get the name of an unpack implementation
+ * @param implementation Implementation to name
+ * @return Name of the implementation, e.g. "AVX2"
+ */
+const char*
+get_unpack_implementation_name(UnpackImplementation implementation) noexcept;
+
+/**
+ * @brief Check whether the CPU running the program can use an unpack implementation
+ * @param implementation Implementation to check
+ * @return Whether unpack_frames() and pack_frames() can be called with this implementation
+ */
+bool
+is_unpack_implementation_supported(UnpackImplementation implementation) noexcept;
+
+/**
+ * @brief Get the implementation used by unpack_frames() and pack_frames() when none is given
+ * @return The fastest implementation supported by the CPU, detected on first use
+ */
+UnpackImplementation
+get_best_unpack_implementation() noexcept;
+
+/**
+ * @brief Decode the ADC values of consecutive WIB2Frames
+ *
+ * The values of each frame are written in the order of WIB2Frame::get_adc(i), i = 0 to 255, and are bit-exact
+ * with it.
+ *
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param adcs Output, with room for num_frames * WIB2Frame::s_num_channels values
+ */
+void
+unpack_frames(const WIB2Frame* frames, size_t num_frames, uint16_t* adcs) noexcept; // NOLINT(build/unsigned)
+
+/**
+ * @brief Decode the ADC values of consecutive WIB2Frames with a given implementation, e.g. to compare them
+ * @param frames First frame
+ * @param num_frames Number of frames
+ * @param adcs Output, with room for num_frames * WIB2Frame::s_num_channels values
+ * @param implementation Implementation to use
+ * @throws WIB2UnpackImplementationUnsupported if the CPU does not support the implementation
+ */
+void
+unpack_frames(const WIB2Frame* frames,
+              size_t num_frames,
+              uint16_t* adcs, // NOLINT(build/unsigned)
+              UnpackImplementation implementation);
+
+/**
+ * @brief Decode the ADC values of one WIB2Frame
+ * @param frame Frame to decode
+ * @param adcs Output, with room for WIB2Frame::s_num_channels values in get_adc() order
+ */
+inline void
+unpack_frame(const WIB2Frame& frame, uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  unpack_frames(&frame, 1, adcs);
+}
+
+/**
+ * @brief Encode the ADC values of consecutive WIB2Frames
+ *
+ * Every bit of the ADC words is written, so the frames need not be zeroed first; the headers are left as they
+ * are. Values are taken in the order of WIB2Frame::set_adc(i, value), i = 0 to 255, and truncated to 14 bits, so
+ * that unpack_frames() returns them unchanged.
+ *
+ * @param adcs Values, num_frames * WIB2Frame::s_num_channels of them
+ * @param frames First frame to write
+ * @param num_frames Number of frames
+ */
+void
+pack_frames(const uint16_t* adcs, WIB2Frame* frames, size_t num_frames) noexcept; // NOLINT(build/unsigned)
+
+/**
+ * @brief Encode the ADC values of consecutive WIB2Frames with a given implementation, e.g. to compare them
+ * @param adcs Values, num_frames * WIB2Frame::s_num_channels of them
+ * @param frames First frame to write
+ * @param num_frames Number of frames
+ * @param implementation Implementation to use
+ * @throws WIB2UnpackImplementationUnsupported if the CPU does not support the implementation
+ */
+void
+pack_frames(const uint16_t* adcs, // NOLINT(build/unsigned)
+            WIB2Frame* frames,
+            size_t num_frames,
+            UnpackImplementation implementation);
+
+/**
+ * @brief Encode the ADC values of one WIB2Frame
+ * @param adcs Values, WIB2Frame::s_num_channels of them in set_adc() order
+ * @param frame Frame to write
+ */
+inline void
+pack_frame(const uint16_t* adcs, WIB2Frame& frame) noexcept // NOLINT(build/unsigned)
+{
+  pack_frames(adcs, &frame, 1);
+}
+
+/**
+ * @brief Write the same header into consecutive WIB2Frames, with timestamps advancing by a fixed step
+ *
+ * Meant for emulators, together with pack_frames(): frame i gets @p header with timestamp
+ * first_timestamp + i * timestamp_step.
+ *
+ * @param frames First frame to write
+ * @param num_frames Number of frames
+ * @param header Header to copy, whose timestamp is ignored
+ * @param first_timestamp Timestamp of the first frame
+ * @param timestamp_step Timestamp difference between consecutive frames, e.g. FrameTimestampStep<WIB2Frame>::value
+ */
+void
+fill_headers(WIB2Frame* frames,
+             size_t num_frames,
+             const WIB2Frame::Header& header,
+             uint64_t first_timestamp, // NOLINT(build/unsigned)
+             uint64_t timestamp_step) noexcept; // NOLINT(build/unsigned)
+
+} // namespace wib2
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_INCLUDE_DATAFORMATS_WIB2_WIB2UNPACK_HPP_
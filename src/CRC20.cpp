@@ -0,0 +1,95 @@
+/**
+ * @file CRC20.cpp Table-driven CRC20 of WIB2 and DAPHNE frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/CRC20.hpp"
+
+#include <array>
+
+namespace dunedaq::dataformats { // NOLINT
+
+namespace {
+
+// The CRC is kept in the top 20 bits of a 32-bit register, so that whole bytes can be shifted in and out of it
+constexpr int s_register_shift = 32 - 20;
+constexpr uint32_t s_register_polynomial = s_crc20_polynomial << s_register_shift; // NOLINT(build/unsigned)
+
+// Bytes processed per step of the main loop, one table each
+constexpr size_t s_slice_bytes = 8;
+
+using crc_table_t = std::array<std::array<uint32_t, 256>, s_slice_bytes>; // NOLINT(build/unsigned)
+
+/**
+ * @brief Build the slicing-by-8 tables: table k holds the register after a byte followed by k zero bytes
+ */
+constexpr crc_table_t
+make_tables()
+{
+  crc_table_t tables{};
+  for (uint32_t byte = 0; byte < 256; ++byte) { // NOLINT(build/unsigned)
+    uint32_t reg = byte << 24;                  // NOLINT(build/unsigned)
+    for (int bit = 0; bit < 8; ++bit) {
+      reg = (reg & 0x80000000) ? (reg << 1) ^ s_register_polynomial : reg << 1;
+    }
+    tables[0][byte] = reg;
+  }
+  for (size_t k = 1; k < s_slice_bytes; ++k) {
+    for (size_t byte = 0; byte < 256; ++byte) {
+      const uint32_t previous = tables[k - 1][byte]; // NOLINT(build/unsigned)
+      tables[k][byte] = (previous << 8) ^ tables[0][previous >> 24];
+    }
+  }
+  return tables;
+}
+
+constexpr crc_table_t s_tables = make_tables();
+
+inline uint32_t // NOLINT(build/unsigned)
+load_big_endian(const uint8_t* bytes) noexcept // NOLINT(build/unsigned)
+{
+  return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 | // NOLINT(build/unsigned)
+         static_cast<uint32_t>(bytes[2]) << 8 | static_cast<uint32_t>(bytes[3]);         // NOLINT(build/unsigned)
+}
+
+} // namespace
+
+uint32_t // NOLINT(build/unsigned)
+compute_crc20(const void* data, size_t size, uint32_t crc) noexcept // NOLINT(build/unsigned)
+{
+  const auto* bytes = static_cast<const uint8_t*>(data); // NOLINT(build/unsigned)
+  uint32_t reg = (crc & s_crc20_mask) << s_register_shift; // NOLINT(build/unsigned)
+
+  for (; size >= s_slice_bytes; size -= s_slice_bytes, bytes += s_slice_bytes) {
+    const uint32_t high = reg ^ load_big_endian(bytes); // NOLINT(build/unsigned)
+    const uint32_t low = load_big_endian(bytes + 4);    // NOLINT(build/unsigned)
+    reg = s_tables[7][high >> 24] ^ s_tables[6][(high >> 16) & 0xFF] ^ s_tables[5][(high >> 8) & 0xFF] ^
+          s_tables[4][high & 0xFF] ^ s_tables[3][low >> 24] ^ s_tables[2][(low >> 16) & 0xFF] ^
+          s_tables[1][(low >> 8) & 0xFF] ^ s_tables[0][low & 0xFF];
+  }
+  for (; size > 0; --size, ++bytes) {
+    reg = (reg << 8) ^ s_tables[0][(reg >> 24) ^ *bytes];
+  }
+  return reg >> s_register_shift;
+}
+
+void
+fill_crc20(const WIB2Frame* frames, size_t num_frames, WIB2Frame::Trailer* trailers) noexcept
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    trailers[i].crc20 = compute_crc20(frames[i]);
+  }
+}
+
+void
+fill_crc20(const DAPHNEFrame* frames, size_t num_frames, DAPHNEFrame::Trailer* trailers) noexcept
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    trailers[i].crc20 = compute_crc20(frames[i]);
+  }
+}
+
+} // namespace dunedaq::dataformats
@@ -0,0 +1,234 @@
+/**
+ * @file FrameTranspose.cpp Conversion of WIB and WIB2 frames to channel-major ADC arrays
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/FrameTranspose.hpp"
+#include "dataformats/wib/WIBUnpack.hpp"
+#include "dataformats/wib2/WIB2Unpack.hpp"
+
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace dunedaq::dataformats { // NOLINT
+
+namespace {
+
+// Ticks decoded per tile: a tile of 256-channel frames is 16 kB, which stays in L1 while it is transposed, and
+// each row receives a whole 64-byte cache line per tile
+constexpr size_t s_tile_ticks = 32;
+// Side of the blocks transposed with 128-bit registers
+constexpr int s_block_size = 8;
+
+/**
+ * @brief Transpose an 8x8 block of values
+ * @param in First value of the block in the tile
+ * @param in_stride Distance between the ticks of the tile
+ * @param out First value of the block in the output
+ * @param out_stride Distance between the rows of the output
+ * @param pedestals Values to subtract from the 8 channels of the block, modulo 2^16, or nullptr
+ */
+inline void
+transpose_block(const uint16_t* in, // NOLINT(build/unsigned)
+                size_t in_stride,
+                uint16_t* out, // NOLINT(build/unsigned)
+                size_t out_stride,
+                const uint16_t* pedestals) noexcept // NOLINT(build/unsigned)
+{
+#ifdef __SSE2__
+  __m128i r[s_block_size];
+  for (int i = 0; i < s_block_size; ++i) {
+    r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * in_stride)); // NOLINT
+  }
+  if (pedestals != nullptr) {
+    const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pedestals)); // NOLINT
+    for (int i = 0; i < s_block_size; ++i) {
+      r[i] = _mm_sub_epi16(r[i], p);
+    }
+  }
+  __m128i a[s_block_size];
+  for (int i = 0; i < s_block_size; i += 2) {
+    a[i] = _mm_unpacklo_epi16(r[i], r[i + 1]);
+    a[i + 1] = _mm_unpackhi_epi16(r[i], r[i + 1]);
+  }
+  __m128i b[s_block_size];
+  for (int i = 0; i < s_block_size; i += 4) {
+    b[i] = _mm_unpacklo_epi32(a[i], a[i + 2]);
+    b[i + 1] = _mm_unpackhi_epi32(a[i], a[i + 2]);
+    b[i + 2] = _mm_unpacklo_epi32(a[i + 1], a[i + 3]);
+    b[i + 3] = _mm_unpackhi_epi32(a[i + 1], a[i + 3]);
+  }
+  for (int i = 0; i < s_block_size / 2; ++i) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i * out_stride), _mm_unpacklo_epi64(b[i], b[i + 4]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (2 * i + 1) * out_stride), _mm_unpackhi_epi64(b[i], b[i + 4]));
+  }
+#else
+  for (int ch = 0; ch < s_block_size; ++ch) {
+    uint16_t pedestal = pedestals != nullptr ? pedestals[ch] : 0; // NOLINT(build/unsigned)
+    for (int tick = 0; tick < s_block_size; ++tick) {
+      out[ch * out_stride + tick] = in[tick * in_stride + ch] - pedestal;
+    }
+  }
+#endif
+}
+
+/**
+ * @brief Write a range of channels of a decoded tile to the channel-major output
+ * @param tile Decoded tile, num_ticks frames of tile_stride values
+ * @param tile_stride Number of channels per frame
+ * @param num_ticks Number of frames in the tile
+ * @param first_channel First channel to write
+ * @param num_channels Number of channels to write
+ * @param out First value of the tile in the output row of first_channel
+ * @param row_stride Distance between the rows of the output
+ * @param pedestals Values to subtract from each channel of the frame, modulo 2^16, or nullptr
+ */
+void
+transpose_tile(const uint16_t* tile, // NOLINT(build/unsigned)
+               size_t tile_stride,
+               size_t num_ticks,
+               int first_channel,
+               int num_channels,
+               uint16_t* out, // NOLINT(build/unsigned)
+               size_t row_stride,
+               const uint16_t* pedestals = nullptr) noexcept // NOLINT(build/unsigned)
+{
+  const size_t block_ticks = num_ticks / s_block_size * s_block_size;
+  const int block_channels = num_channels / s_block_size * s_block_size;
+  for (int ch = 0; ch < block_channels; ch += s_block_size) {
+    for (size_t tick = 0; tick < block_ticks; tick += s_block_size) {
+      transpose_block(tile + tick * tile_stride + first_channel + ch,
+                      tile_stride,
+                      out + ch * row_stride + tick,
+                      row_stride,
+                      pedestals != nullptr ? pedestals + first_channel + ch : nullptr);
+    }
+  }
+  // Edges that do not fill a block
+  for (int ch = 0; ch < num_channels; ++ch) {
+    uint16_t pedestal = pedestals != nullptr ? pedestals[first_channel + ch] : 0; // NOLINT(build/unsigned)
+    for (size_t tick = ch < block_channels ? block_ticks : 0; tick < num_ticks; ++tick) {
+      out[ch * row_stride + tick] = tile[tick * tile_stride + first_channel + ch] - pedestal;
+    }
+  }
+}
+
+/**
+ * @brief Decode frames one tile at a time and transpose each tile
+ * @param unpack Bulk decoder, called as unpack(frames, num_frames, adcs)
+ */
+template<int NumFrameChannels, typename Frame, typename Unpack>
+void
+transpose_frames(const Frame* frames,
+                 size_t num_frames,
+                 uint16_t* adcs, // NOLINT(build/unsigned)
+                 size_t row_stride,
+                 int first_channel,
+                 int num_channels,
+                 Unpack&& unpack)
+{
+  if (first_channel < 0 || num_channels < 0 || num_channels > NumFrameChannels - first_channel) {
+    throw FrameTransposeChannelRangeError(ERS_HERE, first_channel, num_channels, NumFrameChannels);
+  }
+  if (row_stride < num_frames) {
+    throw FrameTransposeRowStrideError(ERS_HERE, row_stride, num_frames);
+  }
+
+  alignas(64) uint16_t tile[s_tile_ticks * NumFrameChannels]; // NOLINT
+  for (size_t first_tick = 0; first_tick < num_frames; first_tick += s_tile_ticks) {
+    size_t num_ticks = std::min(s_tile_ticks, num_frames - first_tick);
+    unpack(frames + first_tick, num_ticks, tile);
+    transpose_tile(tile, NumFrameChannels, num_ticks, first_channel, num_channels, adcs + first_tick, row_stride);
+  }
+}
+
+} // namespace
+
+void
+transpose_to_channel_major(const WIBFrame* frames,
+                           size_t num_frames,
+                           uint16_t* adcs, // NOLINT(build/unsigned)
+                           size_t row_stride,
+                           int first_channel,
+                           int num_channels)
+{
+  transpose_frames<WIBFrame::s_num_ch_per_frame>(
+    frames, num_frames, adcs, row_stride, first_channel, num_channels, [](const WIBFrame* f, size_t n, adc_t* out) {
+      wib::unpack_frames(f, n, out);
+    });
+}
+
+void
+transpose_to_channel_major(const WIB2Frame* frames,
+                           size_t num_frames,
+                           uint16_t* adcs, // NOLINT(build/unsigned)
+                           size_t row_stride,
+                           int first_channel,
+                           int num_channels)
+{
+  transpose_frames<WIB2Frame::s_num_channels>(
+    frames,
+    num_frames,
+    adcs,
+    row_stride,
+    first_channel,
+    num_channels,
+    [](const WIB2Frame* f, size_t n, uint16_t* out) { wib2::unpack_frames(f, n, out); }); // NOLINT(build/unsigned)
+}
+
+void
+transpose_to_planes(const WIB2Frame* frames,
+                    size_t num_frames,
+                    const int16_t* pedestals,
+                    int16_t* u_adcs,
+                    int16_t* v_adcs,
+                    int16_t* x_adcs,
+                    size_t row_stride)
+{
+  if (row_stride < num_frames) {
+    throw FrameTransposeRowStrideError(ERS_HERE, row_stride, num_frames);
+  }
+
+  // Signed and unsigned values may alias, and two's complement subtraction is the same for both
+  const auto* unsigned_pedestals = reinterpret_cast<const uint16_t*>(pedestals); // NOLINT
+  struct Plane
+  {
+    uint16_t* adcs; // NOLINT(build/unsigned)
+    int first_channel;
+    int num_channels;
+  };
+  constexpr int v_offset = WIB2Frame::s_u_channels_per_femb;
+  constexpr int x_offset = v_offset + WIB2Frame::s_v_channels_per_femb;
+  const Plane planes[] = {
+    { reinterpret_cast<uint16_t*>(u_adcs), 0, WIB2Frame::s_u_channels_per_femb },        // NOLINT
+    { reinterpret_cast<uint16_t*>(v_adcs), v_offset, WIB2Frame::s_v_channels_per_femb }, // NOLINT
+    { reinterpret_cast<uint16_t*>(x_adcs), x_offset, WIB2Frame::s_x_channels_per_femb }, // NOLINT
+  };
+
+  // Pedestals are subtracted while transposing, so each value is written to memory only once
+  alignas(64) uint16_t tile[s_tile_ticks * WIB2Frame::s_num_channels]; // NOLINT
+  for (size_t first_tick = 0; first_tick < num_frames; first_tick += s_tile_ticks) {
+    size_t num_ticks = std::min(s_tile_ticks, num_frames - first_tick);
+    wib2::unpack_frames(frames + first_tick, num_ticks, tile);
+    for (int femb = 0; femb < WIB2Frame::s_fembs_per_frame; ++femb) {
+      for (const auto& plane : planes) {
+        transpose_tile(tile,
+                       WIB2Frame::s_num_channels,
+                       num_ticks,
+                       femb * WIB2Frame::s_channels_per_femb + plane.first_channel,
+                       plane.num_channels,
+                       plane.adcs + femb * plane.num_channels * row_stride + first_tick,
+                       row_stride,
+                       unsigned_pedestals);
+      }
+    }
+  }
+}
+
+} // namespace dunedaq::dataformats
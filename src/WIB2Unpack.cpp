@@ -0,0 +1,460 @@
+/**
+ * @file WIB2Unpack.cpp Bulk decoding and encoding of the ADC values of WIB2 frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib2/WIB2Unpack.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DATAFORMATS_WIB2UNPACK_X86 1
+#include <immintrin.h>
+#endif
+
+namespace dunedaq::dataformats::wib2 { // NOLINT
+
+namespace {
+
+// Four 14-bit values fill exactly 7 bytes, so each group of four is decoded from one unaligned 64-bit load
+constexpr int s_adcs_per_group = 4;
+constexpr int s_bytes_per_group = s_adcs_per_group * WIB2Frame::s_bits_per_adc / 8;
+constexpr int s_num_groups = WIB2Frame::s_num_channels / s_adcs_per_group;
+constexpr int s_adc_bytes = s_num_groups * s_bytes_per_group;
+constexpr uint64_t s_adc_mask = (uint64_t(1) << WIB2Frame::s_bits_per_adc) - 1; // NOLINT(build/unsigned)
+
+static_assert(s_adcs_per_group * WIB2Frame::s_bits_per_adc % 8 == 0, "ADC groups must end on a byte boundary");
+static_assert(WIB2Frame::s_num_channels % s_adcs_per_group == 0, "Frames must hold whole ADC groups");
+static_assert(sizeof(WIB2Frame::adc_words) == s_adc_bytes, "The ADC words must hold exactly the ADC groups");
+
+/**
+ * @brief Decode one group of four values from the 64 bits starting at its first byte
+ */
+inline void
+decode_group(uint64_t bits, uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  // Written out so that the shifts are constants
+  adcs[0] = bits & s_adc_mask;
+  adcs[1] = (bits >> WIB2Frame::s_bits_per_adc) & s_adc_mask;
+  adcs[2] = (bits >> 2 * WIB2Frame::s_bits_per_adc) & s_adc_mask;
+  adcs[3] = (bits >> 3 * WIB2Frame::s_bits_per_adc) & s_adc_mask;
+}
+
+void
+unpack_frame_scalar(const WIB2Frame& frame, uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  const auto* bytes = reinterpret_cast<const uint8_t*>(frame.adc_words); // NOLINT
+  uint64_t bits = 0;                                                    // NOLINT(build/unsigned)
+  for (int group = 0; group < s_num_groups - 1; ++group) {
+    std::memcpy(&bits, bytes + group * s_bytes_per_group, sizeof(bits));
+    decode_group(bits, adcs + group * s_adcs_per_group);
+  }
+  // The ADC words end the frame, so the last group is loaded from one byte earlier to stay inside it
+  std::memcpy(&bits, bytes + (s_num_groups - 1) * s_bytes_per_group - 1, sizeof(bits));
+  decode_group(bits >> 8, adcs + (s_num_groups - 1) * s_adcs_per_group);
+}
+
+/**
+ * @brief Encode one group of four values into the 56 low bits of a 64-bit word
+ */
+inline uint64_t // NOLINT(build/unsigned)
+encode_group(const uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  return (adcs[0] & s_adc_mask) | (adcs[1] & s_adc_mask) << WIB2Frame::s_bits_per_adc |
+         (adcs[2] & s_adc_mask) << 2 * WIB2Frame::s_bits_per_adc |
+         (adcs[3] & s_adc_mask) << 3 * WIB2Frame::s_bits_per_adc;
+}
+
+void
+pack_frame_scalar(const uint16_t* adcs, WIB2Frame& frame) noexcept // NOLINT(build/unsigned)
+{
+  auto* bytes = reinterpret_cast<uint8_t*>(frame.adc_words); // NOLINT
+  // Each 64-bit store spills one byte into the next group, which the next store overwrites
+  for (int group = 0; group < s_num_groups - 1; ++group) {
+    uint64_t bits = encode_group(adcs + group * s_adcs_per_group); // NOLINT(build/unsigned)
+    std::memcpy(bytes + group * s_bytes_per_group, &bits, sizeof(bits));
+  }
+  // The ADC words end the frame, so the last group is written as exactly its 7 bytes
+  uint64_t bits = encode_group(adcs + (s_num_groups - 1) * s_adcs_per_group); // NOLINT(build/unsigned)
+  std::memcpy(bytes + (s_num_groups - 1) * s_bytes_per_group, &bits, s_bytes_per_group);
+}
+
+#ifdef DATAFORMATS_WIB2UNPACK_X86
+
+// pshufb mask putting the bytes of the four values of a group starting at byte o of a 128-bit lane into four
+// 32-bit lanes, low byte first; -1 clears the bytes that hold none of the value's bits
+#define DATAFORMATS_WIB2UNPACK_SHUFFLE(o)                                                                           \
+  (o), (o) + 1, -1, -1, (o) + 1, (o) + 2, (o) + 3, -1, (o) + 3, (o) + 4, (o) + 5, -1, (o) + 5, (o) + 6, -1, -1
+
+/**
+ * @brief Decode the two groups in the 16 bytes at a pointer with AVX2, one group per 128-bit lane
+ * @return The eight values, in 32-bit lanes
+ */
+__attribute__((target("avx2"))) inline __m256i
+decode_group_pair_avx2(const uint8_t* bytes, __m256i shuffle) noexcept // NOLINT(build/unsigned)
+{
+  const __m256i shifts = _mm256_setr_epi32(0, 6, 4, 2, 0, 6, 4, 2);
+  __m256i data = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes))); // NOLINT
+  __m256i lanes = _mm256_srlv_epi32(_mm256_shuffle_epi8(data, shuffle), shifts);
+  return _mm256_and_si256(lanes, _mm256_set1_epi32(s_adc_mask));
+}
+
+/**
+ * @brief Store the values of two consecutive group pairs decoded by decode_group_pair_avx2()
+ */
+__attribute__((target("avx2"))) inline void
+store_group_pairs_avx2(uint16_t* adcs, __m256i first, __m256i second) noexcept // NOLINT(build/unsigned)
+{
+  // packus interleaves the 128-bit lanes of its inputs; the permute restores the order of the values
+  __m256i values = _mm256_permute4x64_epi64(_mm256_packus_epi32(first, second), 0xD8);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(adcs), values); // NOLINT
+}
+
+/**
+ * @brief Decode one frame with AVX2, four groups at a time
+ */
+__attribute__((target("avx2"))) void
+unpack_frame_avx2(const WIB2Frame& frame, uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  constexpr int pair_bytes = 2 * s_bytes_per_group;
+  const __m256i shuffle =
+    _mm256_setr_epi8(DATAFORMATS_WIB2UNPACK_SHUFFLE(0), DATAFORMATS_WIB2UNPACK_SHUFFLE(s_bytes_per_group));
+  // The ADC words end the frame, so the last pair is loaded from two bytes earlier to stay inside it
+  const __m256i last_shuffle =
+    _mm256_setr_epi8(DATAFORMATS_WIB2UNPACK_SHUFFLE(2), DATAFORMATS_WIB2UNPACK_SHUFFLE(s_bytes_per_group + 2));
+  const auto* bytes = reinterpret_cast<const uint8_t*>(frame.adc_words); // NOLINT
+
+  for (int pair = 0; pair < s_num_groups / 2 - 2; pair += 2) {
+    store_group_pairs_avx2(adcs + pair * 2 * s_adcs_per_group,
+                           decode_group_pair_avx2(bytes + pair * pair_bytes, shuffle),
+                           decode_group_pair_avx2(bytes + (pair + 1) * pair_bytes, shuffle));
+  }
+  constexpr int last_pair = s_num_groups / 2 - 1;
+  store_group_pairs_avx2(adcs + (last_pair - 1) * 2 * s_adcs_per_group,
+                         decode_group_pair_avx2(bytes + (last_pair - 1) * pair_bytes, shuffle),
+                         decode_group_pair_avx2(bytes + last_pair * pair_bytes - 2, last_shuffle));
+}
+
+#undef DATAFORMATS_WIB2UNPACK_SHUFFLE
+
+// madd_epi16 factors merging two adjacent 16-bit values a, b into the 28-bit field a + (b << 14) of a 32-bit lane
+constexpr int s_pair_factors = (1 << WIB2Frame::s_bits_per_adc) << 16 | 1;
+// Unused bits between two such fields in a 64-bit lane, removed to merge them into one 56-bit group
+constexpr int s_pair_gap_bits = 32 - 2 * WIB2Frame::s_bits_per_adc;
+
+/**
+ * @brief Encode sixteen values with AVX2, the bytes of four groups ending up in bytes 0 to 13 of each 128-bit lane
+ */
+__attribute__((target("avx2"))) inline __m256i
+encode_group_pairs_avx2(const uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  const __m256i low_words = _mm256_set1_epi64x(0xFFFFFFFF);
+  const __m256i compact = _mm256_setr_epi8(
+    0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1, 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, -1, -1);
+  __m256i values = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(adcs)), // NOLINT
+                                    _mm256_set1_epi16(s_adc_mask));
+  // Pairs of values as 28-bit fields of 32-bit lanes, then pairs of pairs as 56-bit fields of 64-bit lanes
+  __m256i pairs = _mm256_madd_epi16(values, _mm256_set1_epi32(s_pair_factors));
+  __m256i groups = _mm256_or_si256(_mm256_and_si256(pairs, low_words),
+                                   _mm256_srli_epi64(_mm256_andnot_si256(low_words, pairs), s_pair_gap_bits));
+  return _mm256_shuffle_epi8(groups, compact);
+}
+
+/**
+ * @brief Encode one frame with AVX2, four groups at a time
+ */
+__attribute__((target("avx2"))) void
+pack_frame_avx2(const uint16_t* adcs, WIB2Frame& frame) noexcept // NOLINT(build/unsigned)
+{
+  constexpr int quad_values = 4 * s_adcs_per_group;
+  constexpr int pair_bytes = 2 * s_bytes_per_group;
+  constexpr int num_quads = s_num_groups / 4;
+  auto* bytes = reinterpret_cast<uint8_t*>(frame.adc_words); // NOLINT
+  // Each 16-byte store spills two bytes into the next pair of groups, which the next store overwrites
+  for (int quad = 0; quad < num_quads - 1; ++quad) {
+    __m256i encoded = encode_group_pairs_avx2(adcs + quad * quad_values);
+    uint8_t* out = bytes + quad * 2 * pair_bytes; // NOLINT(build/unsigned)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(encoded));                 // NOLINT
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + pair_bytes), _mm256_extracti128_si256(encoded, 1)); // NOLINT
+  }
+  // The ADC words end the frame, so the last pair is stored from two bytes earlier, preceded by the end of the
+  // pair before it
+  __m256i encoded = encode_group_pairs_avx2(adcs + (num_quads - 1) * quad_values);
+  __m128i first = _mm256_castsi256_si128(encoded);
+  __m128i last = _mm_alignr_epi8(_mm256_extracti128_si256(encoded, 1), _mm_slli_si128(first, 2), pair_bytes);
+  uint8_t* out = bytes + (num_quads - 1) * 2 * pair_bytes; // NOLINT(build/unsigned)
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), first);                // NOLINT
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out + pair_bytes - 2), last); // NOLINT
+}
+
+/**
+ * @brief Index of the input byte vpermb moves to each byte of the 64-bit lane of a group
+ */
+constexpr uint64_t // NOLINT(build/unsigned)
+get_group_permute(int group)
+{
+  uint64_t indices = 0; // NOLINT(build/unsigned)
+  for (int byte = 0; byte < 8; ++byte) {
+    // The eighth byte only feeds bits that are masked off; repeating the seventh keeps the index in range
+    indices |= static_cast<uint64_t>(group * s_bytes_per_group + std::min(byte, s_bytes_per_group - 1)) // NOLINT
+               << (8 * byte);
+  }
+  return indices;
+}
+
+/**
+ * @brief Decode one frame with AVX-512 VBMI, eight groups at a time
+ *
+ * vpermb moves each group of a 56-byte chunk into its own 64-bit lane, where the four values sit at bits 0, 14,
+ * 28 and 42; vpmultishiftqb then extracts the low and high byte of each value from those bit offsets.
+ */
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) void
+unpack_frame_avx512vbmi(const WIB2Frame& frame, uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  constexpr int chunk_groups = 8;
+  constexpr int chunk_bytes = chunk_groups * s_bytes_per_group;
+  static_assert(s_num_groups % chunk_groups == 0, "Frames must hold whole chunks");
+  // Masked loads of exactly one chunk, so that the last one stays inside the frame
+  constexpr __mmask64 chunk_mask = (__mmask64(1) << chunk_bytes) - 1;
+
+  const __m512i permute = _mm512_set_epi64(get_group_permute(7),
+                                           get_group_permute(6),
+                                           get_group_permute(5),
+                                           get_group_permute(4),
+                                           get_group_permute(3),
+                                           get_group_permute(2),
+                                           get_group_permute(1),
+                                           get_group_permute(0));
+  const __m512i offsets = _mm512_set1_epi64(0x322A241C160E0800); // Bytes 0, 8, 14, 22, 28, 36, 42, 50
+  const __m512i mask = _mm512_set1_epi16(s_adc_mask);
+  const auto* bytes = reinterpret_cast<const uint8_t*>(frame.adc_words); // NOLINT
+  // The all-lanes maskz forms compile to the same instructions as the unmasked intrinsics, whose GCC definitions
+  // trigger -Wuninitialized false positives
+  constexpr __mmask64 all_lanes = ~__mmask64(0);
+  for (int chunk = 0; chunk < s_num_groups / chunk_groups; ++chunk) {
+    __m512i data = _mm512_maskz_loadu_epi8(chunk_mask, bytes + chunk * chunk_bytes);
+    __m512i groups = _mm512_maskz_permutexvar_epi8(all_lanes, permute, data);
+    __m512i values = _mm512_maskz_multishift_epi64_epi8(all_lanes, offsets, groups);
+    _mm512_storeu_si512(adcs + chunk * chunk_groups * s_adcs_per_group, _mm512_and_si512(values, mask));
+  }
+}
+
+/**
+ * @brief Index of the byte vpermb moves to each of the output bytes 8 * part to 8 * part + 7 of a 56-byte chunk
+ */
+constexpr uint64_t // NOLINT(build/unsigned)
+get_chunk_compact(int part)
+{
+  uint64_t indices = 0; // NOLINT(build/unsigned)
+  for (int byte = 0; byte < 8; ++byte) {
+    // Seven bytes from each 64-bit lane; bytes past the chunk are not stored, and take byte 0
+    int output = 8 * part + byte < 8 * s_bytes_per_group ? 8 * part + byte : 0;
+    indices |= static_cast<uint64_t>(output / s_bytes_per_group * 8 + output % s_bytes_per_group) // NOLINT
+               << (8 * byte);
+  }
+  return indices;
+}
+
+/**
+ * @brief Encode one frame with AVX-512 VBMI, eight groups at a time
+ *
+ * The inverse of unpack_frame_avx512vbmi(): the values are merged into 56-bit fields of 64-bit lanes, and vpermb
+ * moves the seven bytes of each lane next to each other.
+ */
+__attribute__((target("avx512f,avx512bw,avx512vbmi"))) void
+pack_frame_avx512vbmi(const uint16_t* adcs, WIB2Frame& frame) noexcept // NOLINT(build/unsigned)
+{
+  constexpr int chunk_groups = 8;
+  constexpr int chunk_bytes = chunk_groups * s_bytes_per_group;
+  // Masked stores of exactly one chunk, so that the last one stays inside the frame
+  constexpr __mmask64 chunk_mask = (__mmask64(1) << chunk_bytes) - 1;
+
+  const __m512i compact = _mm512_set_epi64(get_chunk_compact(7),
+                                           get_chunk_compact(6),
+                                           get_chunk_compact(5),
+                                           get_chunk_compact(4),
+                                           get_chunk_compact(3),
+                                           get_chunk_compact(2),
+                                           get_chunk_compact(1),
+                                           get_chunk_compact(0));
+  const __m512i low_words = _mm512_set1_epi64(0xFFFFFFFF);
+  const __m512i mask = _mm512_set1_epi16(s_adc_mask);
+  const __m512i pair_factors = _mm512_set1_epi32(s_pair_factors);
+  // As in unpack_frame_avx512vbmi(), all-lanes maskz forms avoid -Wuninitialized false positives
+  constexpr __mmask64 all_lanes = ~__mmask64(0);
+  constexpr __mmask8 all_words = ~__mmask8(0);
+  auto* bytes = reinterpret_cast<uint8_t*>(frame.adc_words); // NOLINT
+  for (int chunk = 0; chunk < s_num_groups / chunk_groups; ++chunk) {
+    __m512i values = _mm512_and_si512(_mm512_loadu_si512(adcs + chunk * chunk_groups * s_adcs_per_group), mask);
+    __m512i pairs = _mm512_madd_epi16(values, pair_factors);
+    __m512i high_pairs = _mm512_maskz_andnot_epi64(all_words, low_words, pairs);
+    __m512i groups = _mm512_or_si512(_mm512_and_si512(pairs, low_words),
+                                     _mm512_maskz_srli_epi64(all_words, high_pairs, s_pair_gap_bits));
+    _mm512_mask_storeu_epi8(
+      bytes + chunk * chunk_bytes, chunk_mask, _mm512_maskz_permutexvar_epi8(all_lanes, compact, groups));
+  }
+}
+
+#endif // DATAFORMATS_WIB2UNPACK_X86
+
+using unpack_function_t = void (*)(const WIB2Frame&, uint16_t*) noexcept; // NOLINT(build/unsigned)
+
+unpack_function_t
+get_unpack_function(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+#ifdef DATAFORMATS_WIB2UNPACK_X86
+    case UnpackImplementation::kAVX512VBMI:
+      return unpack_frame_avx512vbmi;
+    case UnpackImplementation::kAVX2:
+      return unpack_frame_avx2;
+#endif
+    default:
+      return unpack_frame_scalar;
+  }
+}
+
+using pack_function_t = void (*)(const uint16_t*, WIB2Frame&) noexcept; // NOLINT(build/unsigned)
+
+pack_function_t
+get_pack_function(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+#ifdef DATAFORMATS_WIB2UNPACK_X86
+    case UnpackImplementation::kAVX512VBMI:
+      return pack_frame_avx512vbmi;
+    case UnpackImplementation::kAVX2:
+      return pack_frame_avx2;
+#endif
+    default:
+      return pack_frame_scalar;
+  }
+}
+
+void
+pack_frames_with(pack_function_t pack,
+                 const uint16_t* adcs, // NOLINT(build/unsigned)
+                 WIB2Frame* frames,
+                 size_t num_frames) noexcept
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    pack(adcs + i * WIB2Frame::s_num_channels, frames[i]);
+  }
+}
+
+void
+unpack_frames_with(unpack_function_t unpack,
+                   const WIB2Frame* frames,
+                   size_t num_frames,
+                   uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    unpack(frames[i], adcs + i * WIB2Frame::s_num_channels);
+  }
+}
+
+} // namespace
+
+const char*
+get_unpack_implementation_name(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+    case UnpackImplementation::kScalar:
+      return "scalar";
+    case UnpackImplementation::kAVX2:
+      return "AVX2";
+    case UnpackImplementation::kAVX512VBMI:
+      return "AVX-512 VBMI";
+  }
+  return "unknown";
+}
+
+bool
+is_unpack_implementation_supported(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+    case UnpackImplementation::kScalar:
+      return true;
+#ifdef DATAFORMATS_WIB2UNPACK_X86
+    case UnpackImplementation::kAVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    case UnpackImplementation::kAVX512VBMI:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi");
+#endif
+    default:
+      return false;
+  }
+}
+
+UnpackImplementation
+get_best_unpack_implementation() noexcept
+{
+  static const UnpackImplementation best = [] {
+    for (auto implementation : { UnpackImplementation::kAVX512VBMI, UnpackImplementation::kAVX2 }) {
+      if (is_unpack_implementation_supported(implementation)) {
+        return implementation;
+      }
+    }
+    return UnpackImplementation::kScalar;
+  }();
+  return best;
+}
+
+void
+unpack_frames(const WIB2Frame* frames, size_t num_frames, uint16_t* adcs) noexcept // NOLINT(build/unsigned)
+{
+  static const unpack_function_t unpack = get_unpack_function(get_best_unpack_implementation());
+  unpack_frames_with(unpack, frames, num_frames, adcs);
+}
+
+void
+unpack_frames(const WIB2Frame* frames,
+              size_t num_frames,
+              uint16_t* adcs, // NOLINT(build/unsigned)
+              UnpackImplementation implementation)
+{
+  if (!is_unpack_implementation_supported(implementation)) {
+    throw WIB2UnpackImplementationUnsupported(ERS_HERE, get_unpack_implementation_name(implementation));
+  }
+  unpack_frames_with(get_unpack_function(implementation), frames, num_frames, adcs);
+}
+
+void
+pack_frames(const uint16_t* adcs, WIB2Frame* frames, size_t num_frames) noexcept // NOLINT(build/unsigned)
+{
+  static const pack_function_t pack = get_pack_function(get_best_unpack_implementation());
+  pack_frames_with(pack, adcs, frames, num_frames);
+}
+
+void
+pack_frames(const uint16_t* adcs, // NOLINT(build/unsigned)
+            WIB2Frame* frames,
+            size_t num_frames,
+            UnpackImplementation implementation)
+{
+  if (!is_unpack_implementation_supported(implementation)) {
+    throw WIB2UnpackImplementationUnsupported(ERS_HERE, get_unpack_implementation_name(implementation));
+  }
+  pack_frames_with(get_pack_function(implementation), adcs, frames, num_frames);
+}
+
+void
+fill_headers(WIB2Frame* frames,
+             size_t num_frames,
+             const WIB2Frame::Header& header,
+             uint64_t first_timestamp, // NOLINT(build/unsigned)
+             uint64_t timestamp_step) noexcept // NOLINT(build/unsigned)
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    frames[i].header = header;
+    frames[i].set_timestamp(first_timestamp + i * timestamp_step);
+  }
+}
+
+} // namespace dunedaq::dataformats::wib2
@@ -0,0 +1,134 @@
+/**
+ * @file WIBChecksum.cpp Computation and verification of the COLDATA checksums of WIB1 frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBChecksum.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace dunedaq::dataformats::wib { // NOLINT
+
+namespace {
+
+constexpr size_t s_data_bytes = sizeof(ColdataBlock) - sizeof(ColdataHeader);
+
+static_assert(s_data_bytes == ColdataBlock::s_num_seg_per_block * sizeof(ColdataSegment),
+              "ColdataBlock must be a header followed by its segments");
+#ifdef __SSE2__
+static_assert(s_data_bytes % 16 == 0, "COLDATA data must fill whole 128-bit registers");
+#endif
+
+} // namespace
+
+ColdataChecksums
+compute_coldata_checksums(const ColdataBlock& block) noexcept
+{
+  const auto* data = reinterpret_cast<const uint8_t*>(&block) + sizeof(ColdataHeader); // NOLINT
+  ColdataChecksums checksums;
+#ifdef __SSE2__
+  // Split even and odd bytes into 16-bit lanes, then let psadbw sum each half of the register
+  const __m128i even_mask = _mm_set1_epi16(0x00FF);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sum_a = zero;
+  __m128i sum_b = zero;
+  for (size_t i = 0; i < s_data_bytes; i += 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)); // NOLINT
+    sum_a = _mm_add_epi64(sum_a, _mm_sad_epu8(_mm_and_si128(bytes, even_mask), zero));
+    sum_b = _mm_add_epi64(sum_b, _mm_sad_epu8(_mm_srli_epi16(bytes, 8), zero));
+  }
+  checksums.a = _mm_cvtsi128_si32(sum_a) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sum_a, sum_a));
+  checksums.b = _mm_cvtsi128_si32(sum_b) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sum_b, sum_b));
+#else
+  for (size_t i = 0; i < s_data_bytes; i += 2) {
+    checksums.a += data[i];
+    checksums.b += data[i + 1];
+  }
+#endif
+  return checksums;
+}
+
+uint8_t // NOLINT(build/unsigned)
+verify_coldata_checksums(const WIBFrame& frame) noexcept
+{
+  uint8_t mismatches = 0; // NOLINT(build/unsigned)
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    const ColdataBlock& coldata = frame.get_block(block);
+    auto checksums = compute_coldata_checksums(coldata);
+    mismatches |= (checksums.a != coldata.head.get_checksum_a()) << (2 * block);
+    mismatches |= (checksums.b != coldata.head.get_checksum_b()) << (2 * block + 1);
+  }
+  return mismatches;
+}
+
+void
+fill_coldata_checksums(WIBFrame* frames, size_t num_frames) noexcept
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+      auto checksums = compute_coldata_checksums(frames[i].get_block(block));
+      frames[i].get_coldata_header(block)->set_checksum_a(checksums.a);
+      frames[i].get_coldata_header(block)->set_checksum_b(checksums.b);
+    }
+  }
+}
+
+size_t
+ColdataChecksumSummary::add(const WIBFrame* frames, size_t num_frames)
+{
+  // Frames usually come in long runs from one link, so each run costs a single map lookup
+  size_t num_bad_frames = 0;
+  size_t run_begin = 0;
+  while (run_begin < num_frames) {
+    const WIBLinkID link = get_link_id(*frames[run_begin].get_wib_header());
+    ColdataChecksumCounts run_counts;
+    size_t i = run_begin;
+    for (; i < num_frames && get_link_id(*frames[i].get_wib_header()) == link; ++i) {
+      uint8_t mismatches = verify_coldata_checksums(frames[i]); // NOLINT(build/unsigned)
+      if (mismatches != 0) {
+        ++run_counts.num_bad_frames;
+        for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+          run_counts.num_bad_a += (mismatches >> (2 * block)) & 1;
+          run_counts.num_bad_b += (mismatches >> (2 * block + 1)) & 1;
+        }
+      }
+    }
+    run_counts.num_frames = i - run_begin;
+    m_links[link].merge(run_counts);
+    num_bad_frames += run_counts.num_bad_frames;
+    run_begin = i;
+  }
+  return num_bad_frames;
+}
+
+void
+ColdataChecksumSummary::merge(const ColdataChecksumSummary& other)
+{
+  for (auto& [link, counts] : other.m_links) {
+    m_links[link].merge(counts);
+  }
+}
+
+ColdataChecksumCounts
+ColdataChecksumSummary::get_counts(const WIBLinkID& link) const
+{
+  auto it = m_links.find(link);
+  return it == m_links.end() ? ColdataChecksumCounts() : it->second;
+}
+
+ColdataChecksumCounts
+ColdataChecksumSummary::get_total() const
+{
+  ColdataChecksumCounts total;
+  for (auto& [link, counts] : m_links) {
+    total.merge(counts);
+  }
+  return total;
+}
+
+} // namespace dunedaq::dataformats::wib
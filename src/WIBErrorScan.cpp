@@ -0,0 +1,183 @@
+/**
+ * @file WIBErrorScan.cpp Counting of the error fields in the headers of WIB1 frames
+ *
+ * This is part of the DUNE DAQ , copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBErrorScan.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace dunedaq::dataformats::wib { // NOLINT
+
+namespace {
+
+// Frames checked together before looking for the ones with errors
+constexpr size_t s_block_frames = 64;
+
+// Error fields as masks over the 32-bit words of each header: WIBHeader word 1 holds mm, oos and wib_errors;
+// ColdataHeader word 0 holds s1_error and s2_error, and word 2 error_register
+constexpr uint32_t s_wib_header_masks[4] = { 0, 0xFFFF0003, 0, 0 };    // NOLINT(build/unsigned)
+constexpr uint32_t s_coldata_header_masks[4] = { 0xFF, 0, 0xFFFF, 0 }; // NOLINT(build/unsigned)
+
+static_assert(sizeof(WIBHeader) == sizeof(s_wib_header_masks), "WIBHeader must be four words");
+static_assert(sizeof(ColdataHeader) == sizeof(s_coldata_header_masks), "ColdataHeader must be four words");
+
+/**
+ * @brief Check whether any of a range of frames has an error field set
+ */
+bool
+any_errors(const WIBFrame* frames, size_t num_frames) noexcept
+{
+#ifdef __SSE2__
+  const __m128i wib_mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_wib_header_masks));         // NOLINT
+  const __m128i coldata_mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s_coldata_header_masks)); // NOLINT
+  __m128i errors = _mm_setzero_si128();
+  for (size_t i = 0; i < num_frames; ++i) {
+    const auto* wib_header = reinterpret_cast<const __m128i*>(frames[i].get_wib_header()); // NOLINT
+    errors = _mm_or_si128(errors, _mm_and_si128(_mm_loadu_si128(wib_header), wib_mask));
+    for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+      const auto* coldata_header = reinterpret_cast<const __m128i*>(&frames[i].get_block(block).head); // NOLINT
+      errors = _mm_or_si128(errors, _mm_and_si128(_mm_loadu_si128(coldata_header), coldata_mask));
+    }
+  }
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) != 0xFFFF;
+#else
+  uint32_t errors = 0; // NOLINT(build/unsigned)
+  for (size_t i = 0; i < num_frames; ++i) {
+    uint32_t words[4]; // NOLINT(build/unsigned)
+    std::memcpy(words, frames[i].get_wib_header(), sizeof(words));
+    errors |= words[1] & s_wib_header_masks[1];
+    for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+      std::memcpy(words, &frames[i].get_block(block).head, sizeof(words));
+      errors |= (words[0] & s_coldata_header_masks[0]) | (words[2] & s_coldata_header_masks[2]);
+    }
+  }
+  return errors != 0;
+#endif
+}
+
+} // namespace
+
+bool
+WIBErrorCounts::add(const WIBFrame& frame) noexcept
+{
+  const WIBHeader& header = *frame.get_wib_header();
+  bool has_errors = header.mm || header.oos || header.wib_errors;
+  num_mm += header.mm;
+  num_oos += header.oos;
+  num_wib_errors += header.wib_errors != 0;
+  wib_errors_or |= header.wib_errors;
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    const ColdataHeader& coldata = frame.get_block(block).head;
+    has_errors |= coldata.s1_error || coldata.s2_error || coldata.error_register;
+    num_s1_errors += coldata.s1_error != 0;
+    num_s2_errors += coldata.s2_error != 0;
+    num_error_registers += coldata.error_register != 0;
+    s1_error_or |= coldata.s1_error;
+    s2_error_or |= coldata.s2_error;
+    error_register_or |= coldata.error_register;
+  }
+  ++num_frames;
+  num_frames_with_errors += has_errors;
+  return has_errors;
+}
+
+void
+WIBErrorCounts::merge(const WIBErrorCounts& other) noexcept
+{
+  num_frames += other.num_frames;
+  num_frames_with_errors += other.num_frames_with_errors;
+  num_mm += other.num_mm;
+  num_oos += other.num_oos;
+  num_wib_errors += other.num_wib_errors;
+  num_s1_errors += other.num_s1_errors;
+  num_s2_errors += other.num_s2_errors;
+  num_error_registers += other.num_error_registers;
+  wib_errors_or |= other.wib_errors_or;
+  error_register_or |= other.error_register_or;
+  s1_error_or |= other.s1_error_or;
+  s2_error_or |= other.s2_error_or;
+}
+
+size_t
+WIBErrorSummary::add(const WIBFrame* frames, size_t num_frames)
+{
+  // Frames usually come in long runs from one link, so each run costs a single map lookup
+  size_t num_frames_with_errors = 0;
+  size_t run_begin = 0;
+  while (run_begin < num_frames) {
+    const WIBLinkID link = get_link_id(*frames[run_begin].get_wib_header());
+    size_t run_end = run_begin + 1;
+    while (run_end < num_frames && get_link_id(*frames[run_end].get_wib_header()) == link) {
+      ++run_end;
+    }
+
+    WIBErrorCounts run_counts;
+    for (size_t begin = run_begin; begin < run_end; begin += s_block_frames) {
+      const size_t end = std::min(begin + s_block_frames, run_end);
+      if (!any_errors(frames + begin, end - begin)) {
+        run_counts.num_frames += end - begin;
+        continue;
+      }
+      for (size_t i = begin; i < end; ++i) {
+        run_counts.add(frames[i]);
+      }
+    }
+    m_links[link].merge(run_counts);
+    num_frames_with_errors += run_counts.num_frames_with_errors;
+    run_begin = run_end;
+  }
+  return num_frames_with_errors;
+}
+
+size_t
+WIBErrorSummary::add(const Fragment& fragment)
+{
+  return add(static_cast<const WIBFrame*>(fragment.get_data()),
+             (fragment.get_size() - sizeof(FragmentHeader)) / sizeof(WIBFrame));
+}
+
+size_t
+WIBErrorSummary::add(Fragment& fragment, FragmentErrorBits error_bit)
+{
+  size_t num_frames_with_errors = add(static_cast<const Fragment&>(fragment));
+  if (num_frames_with_errors != 0) {
+    fragment.set_error_bit(error_bit, true);
+  }
+  return num_frames_with_errors;
+}
+
+void
+WIBErrorSummary::merge(const WIBErrorSummary& other)
+{
+  for (auto& [link, counts] : other.m_links) {
+    m_links[link].merge(counts);
+  }
+}
+
+WIBErrorCounts
+WIBErrorSummary::get_counts(const WIBLinkID& link) const
+{
+  auto it = m_links.find(link);
+  return it == m_links.end() ? WIBErrorCounts() : it->second;
+}
+
+WIBErrorCounts
+WIBErrorSummary::get_total() const
+{
+  WIBErrorCounts total;
+  for (auto& [link, counts] : m_links) {
+    total.merge(counts);
+  }
+  return total;
+}
+
+} // namespace dunedaq::dataformats::wib
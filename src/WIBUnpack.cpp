@@ -1,11 +1,402 @@
 /**
- * @file WIBUnpack.cpp Target for compilation of WIB support library
+ * @file WIBUnpack.cpp Bulk decoding and encoding of the ADC values of WIB1 frames
  *
  * This is part of the DUNE DAQ , copyright 2020.
  * Licensing/copyright details are in the COPYING file that you should have
  * received with this code.
  */
 
-#include "dataformats/wib/WIBFrame.hpp"
+#include "dataformats/wib/WIBUnpack.hpp"
 
-namespace dunedaq::dataformats::wib {} // namespace dunedaq::dataformats::wib // NOLINT
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DATAFORMATS_WIBUNPACK_X86 1
+#include <immintrin.h>
+#endif
+
+namespace dunedaq::dataformats::wib { // NOLINT
+
+namespace {
+
+// Byte layout of a WIBFrame: a WIBHeader, then four ColdataBlocks, each a ColdataHeader followed by eight
+// 12-byte ColdataSegments. Segment s of a block holds channels 4 * (s % 2) to 4 * (s % 2) + 3 of ADCs
+// 2 * (s / 2) (even bytes) and 2 * (s / 2) + 1 (odd bytes), packed as four 12-bit values per ADC.
+constexpr size_t s_frame_header_bytes = sizeof(WIBHeader);
+constexpr size_t s_block_header_bytes = sizeof(ColdataHeader);
+constexpr size_t s_block_bytes = sizeof(ColdataBlock);
+constexpr size_t s_segment_bytes = sizeof(ColdataSegment);
+constexpr int s_num_segments = ColdataBlock::s_num_seg_per_block;
+constexpr int s_num_ch_per_block = ColdataBlock::s_num_ch_per_block;
+constexpr int s_num_ch_per_adc = ColdataBlock::s_num_ch_per_adc;
+
+static_assert(s_segment_bytes == 12, "ColdataSegment must be 12 bytes");
+static_assert(s_block_bytes == s_block_header_bytes + s_num_segments * s_segment_bytes,
+              "ColdataBlock must be a header followed by its segments");
+static_assert(sizeof(WIBFrame) == s_frame_header_bytes + WIBFrame::s_num_block_per_frame * s_block_bytes,
+              "WIBFrame must be a header followed by its blocks");
+
+/**
+ * @brief Get the first segment of a block
+ */
+inline const uint8_t* // NOLINT(build/unsigned)
+get_segments(const WIBFrame& frame, int block)
+{
+  return reinterpret_cast<const uint8_t*>(&frame) + s_frame_header_bytes + block * s_block_bytes + // NOLINT
+         s_block_header_bytes;
+}
+
+inline uint8_t* // NOLINT(build/unsigned)
+get_segments(WIBFrame& frame, int block)
+{
+  return reinterpret_cast<uint8_t*>(&frame) + s_frame_header_bytes + block * s_block_bytes + // NOLINT
+         s_block_header_bytes;
+}
+
+/**
+ * @brief Decode one frame, one segment at a time
+ */
+void
+unpack_frame_scalar(const WIBFrame& frame, adc_t* adcs) noexcept
+{
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    const uint8_t* segment = get_segments(frame, block); // NOLINT(build/unsigned)
+    adc_t* block_adcs = adcs + block * s_num_ch_per_block;
+    for (int seg = 0; seg < s_num_segments; ++seg, segment += s_segment_bytes) {
+      // Channel c of ADC parity p spans bytes p + 2 * (3c / 2) and the byte two after it, shifted by 4 for odd c
+      for (int parity = 0; parity < 2; ++parity) {
+        const uint8_t* b = segment + parity; // NOLINT(build/unsigned)
+        adc_t* out = block_adcs + ((seg / 2) * 2 + parity) * s_num_ch_per_adc + (seg % 2) * 4;
+        out[0] = (b[0] | b[2] << 8) & 0xFFF;
+        out[1] = (b[2] | b[4] << 8) >> 4;
+        out[2] = (b[6] | b[8] << 8) & 0xFFF;
+        out[3] = (b[8] | b[10] << 8) >> 4;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Encode one frame, one segment at a time. Values are truncated to 12 bits, as by WIBFrame::set_channel
+ */
+void
+pack_frame_scalar(const adc_t* adcs, WIBFrame& frame) noexcept
+{
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    uint8_t* segment = get_segments(frame, block); // NOLINT(build/unsigned)
+    const adc_t* block_adcs = adcs + block * s_num_ch_per_block;
+    for (int seg = 0; seg < s_num_segments; ++seg, segment += s_segment_bytes) {
+      for (int parity = 0; parity < 2; ++parity) {
+        uint8_t* b = segment + parity; // NOLINT(build/unsigned)
+        const adc_t* in = block_adcs + ((seg / 2) * 2 + parity) * s_num_ch_per_adc + (seg % 2) * 4;
+        b[0] = in[0];
+        b[2] = (in[0] >> 8 & 0xF) | in[1] << 4;
+        b[4] = in[1] >> 4;
+        b[6] = in[2];
+        b[8] = (in[2] >> 8 & 0xF) | in[3] << 4;
+        b[10] = in[3] >> 4;
+      }
+    }
+  }
+}
+
+#ifdef DATAFORMATS_WIBUNPACK_X86
+
+// Byte shuffle turning a 12-byte segment into eight 16-bit lanes: lanes 0-3 hold channels 0-3 of the even ADC,
+// lanes 4-7 those of the odd ADC. Even lanes need masking to 12 bits, odd lanes a shift by 4
+#define DATAFORMATS_WIBUNPACK_SHUFFLE(o)                                                                               \
+  0 + (o), 2 + (o), 2 + (o), 4 + (o), 6 + (o), 8 + (o), 8 + (o), 10 + (o), 1 + (o), 3 + (o), 3 + (o), 5 + (o),        \
+    7 + (o), 9 + (o), 9 + (o), 11 + (o)
+
+/**
+ * @brief Decode the 16 bytes loaded from a segment with SSSE3
+ */
+__attribute__((target("ssse3"))) inline __m128i
+decode_segment_ssse3(const uint8_t* bytes, __m128i shuffle) noexcept // NOLINT(build/unsigned)
+{
+  __m128i lanes = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)), shuffle); // NOLINT
+  return _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi32(0x00000FFF)),
+                      _mm_and_si128(_mm_srli_epi16(lanes, 4), _mm_set1_epi32(static_cast<int>(0xFFFF0000))));
+}
+
+/**
+ * @brief Decode one frame with SSSE3, two segments at a time
+ */
+__attribute__((target("ssse3"))) void
+unpack_frame_ssse3(const WIBFrame& frame, adc_t* adcs) noexcept
+{
+  const __m128i shuffle = _mm_setr_epi8(DATAFORMATS_WIBUNPACK_SHUFFLE(0));
+  // The last segment of a block is loaded from 4 bytes earlier, so that the 16-byte load stays inside the frame
+  const __m128i shuffle_last = _mm_setr_epi8(DATAFORMATS_WIBUNPACK_SHUFFLE(4));
+
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    const uint8_t* segments = get_segments(frame, block); // NOLINT(build/unsigned)
+    adc_t* block_adcs = adcs + block * s_num_ch_per_block;
+    for (int seg = 0; seg < s_num_segments; seg += 2) {
+      const uint8_t* first = segments + seg * s_segment_bytes; // NOLINT(build/unsigned)
+      bool last = seg + 1 == s_num_segments - 1;
+      __m128i low = decode_segment_ssse3(first, shuffle);
+      __m128i high = last ? decode_segment_ssse3(first + s_segment_bytes - 4, shuffle_last)
+                          : decode_segment_ssse3(first + s_segment_bytes, shuffle);
+      // low holds channels 0-3 of ADCs seg and seg + 1, high channels 4-7 of the same two ADCs
+      adc_t* out = block_adcs + seg * s_num_ch_per_adc;
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi64(low, high));                    // NOLINT
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + s_num_ch_per_adc), _mm_unpackhi_epi64(low, high)); // NOLINT
+    }
+  }
+}
+
+/**
+ * @brief Decode one frame with AVX2, two segments (one per 128-bit lane) at a time
+ */
+__attribute__((target("avx2"))) void
+unpack_frame_avx2(const WIBFrame& frame, adc_t* adcs) noexcept
+{
+  const __m256i shuffle = _mm256_setr_epi8(DATAFORMATS_WIBUNPACK_SHUFFLE(0), DATAFORMATS_WIBUNPACK_SHUFFLE(0));
+  const __m256i shuffle_last = _mm256_setr_epi8(DATAFORMATS_WIBUNPACK_SHUFFLE(0), DATAFORMATS_WIBUNPACK_SHUFFLE(4));
+  const __m256i mask = _mm256_set1_epi16(0x0FFF);
+
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    const uint8_t* segments = get_segments(frame, block); // NOLINT(build/unsigned)
+    adc_t* block_adcs = adcs + block * s_num_ch_per_block;
+    for (int seg = 0; seg < s_num_segments; seg += 2) {
+      const uint8_t* first = segments + seg * s_segment_bytes; // NOLINT(build/unsigned)
+      bool last = seg + 1 == s_num_segments - 1;
+      const uint8_t* second = first + s_segment_bytes - (last ? 4 : 0);    // NOLINT(build/unsigned)
+      __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));   // NOLINT
+      __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second)); // NOLINT
+      __m256i lanes = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1),
+                                          last ? shuffle_last : shuffle);
+      lanes = _mm256_blend_epi16(_mm256_and_si256(lanes, mask), _mm256_srli_epi16(lanes, 4), 0xAA);
+      // Qwords hold channels 0-3 of ADCs seg and seg + 1, then channels 4-7 of both; group them by ADC
+      lanes = _mm256_permute4x64_epi64(lanes, _MM_SHUFFLE(3, 1, 2, 0));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(block_adcs + seg * s_num_ch_per_adc), lanes); // NOLINT
+    }
+  }
+}
+
+#undef DATAFORMATS_WIBUNPACK_SHUFFLE
+
+// Packing works on 32-bit lanes holding two 12-bit values of one ADC, combined by _mm_madd_epi16 as
+// first + (second << 12). Interleaving the bytes of the even and the odd ADC then gives the byte order of a
+// segment, with every fourth byte unused; this shuffle drops those bytes
+#define DATAFORMATS_WIBPACK_COMPACT 0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1
+
+/**
+ * @brief Store the 12 bytes of a segment held in the low bytes of a vector
+ *
+ * Other segments are written with a 16-byte store, whose last 4 bytes are overwritten by the next segment. The
+ * last segment of a block is followed by the next ColdataHeader, so it is written in two parts.
+ */
+__attribute__((target("ssse3"))) inline void
+store_segment(uint8_t* segment, __m128i bytes, bool last) noexcept // NOLINT(build/unsigned)
+{
+  if (last) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(segment), bytes); // NOLINT
+    int tail = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+    std::memcpy(segment + 8, &tail, 4);
+  } else {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(segment), bytes); // NOLINT
+  }
+}
+
+/**
+ * @brief Encode one frame with SSSE3, two segments at a time
+ */
+__attribute__((target("ssse3"))) void
+pack_frame_ssse3(const adc_t* adcs, WIBFrame& frame) noexcept
+{
+  const __m128i compact = _mm_setr_epi8(DATAFORMATS_WIBPACK_COMPACT);
+  const __m128i mask = _mm_set1_epi16(0x0FFF);
+  const __m128i combine = _mm_set1_epi32(0x10000001);
+
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    uint8_t* segments = get_segments(frame, block); // NOLINT(build/unsigned)
+    const adc_t* block_adcs = adcs + block * s_num_ch_per_block;
+    for (int seg = 0; seg < s_num_segments; seg += 2) {
+      // Channels 0-7 of ADCs seg and seg + 1
+      const adc_t* in = block_adcs + seg * s_num_ch_per_adc;
+      __m128i even = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));                    // NOLINT
+      __m128i odd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + s_num_ch_per_adc)); // NOLINT
+      even = _mm_madd_epi16(_mm_and_si128(even, mask), combine);
+      odd = _mm_madd_epi16(_mm_and_si128(odd, mask), combine);
+      uint8_t* out = segments + seg * s_segment_bytes; // NOLINT(build/unsigned)
+      store_segment(out, _mm_shuffle_epi8(_mm_unpacklo_epi8(even, odd), compact), false);
+      store_segment(
+        out + s_segment_bytes, _mm_shuffle_epi8(_mm_unpackhi_epi8(even, odd), compact), seg + 1 == s_num_segments - 1);
+    }
+  }
+}
+
+/**
+ * @brief Encode one frame with AVX2, four segments at a time
+ */
+__attribute__((target("avx2"))) void
+pack_frame_avx2(const adc_t* adcs, WIBFrame& frame) noexcept
+{
+  const __m256i compact = _mm256_setr_epi8(DATAFORMATS_WIBPACK_COMPACT, DATAFORMATS_WIBPACK_COMPACT);
+  const __m256i mask = _mm256_set1_epi16(0x0FFF);
+  const __m256i combine = _mm256_set1_epi32(0x10000001);
+
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    uint8_t* segments = get_segments(frame, block); // NOLINT(build/unsigned)
+    const adc_t* block_adcs = adcs + block * s_num_ch_per_block;
+    for (int seg = 0; seg < s_num_segments; seg += 4) {
+      // Channels 0-7 of ADCs seg to seg + 3
+      const adc_t* in = block_adcs + seg * s_num_ch_per_adc;
+      __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));                         // NOLINT
+      __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * s_num_ch_per_adc)); // NOLINT
+      // Lanes hold ADCs (seg, seg + 2) and (seg + 1, seg + 3)
+      __m256i even = _mm256_permute2x128_si256(first, second, 0x20);
+      __m256i odd = _mm256_permute2x128_si256(first, second, 0x31);
+      even = _mm256_madd_epi16(_mm256_and_si256(even, mask), combine);
+      odd = _mm256_madd_epi16(_mm256_and_si256(odd, mask), combine);
+      // Lanes hold segments (seg, seg + 2) and (seg + 1, seg + 3)
+      __m256i low = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(even, odd), compact);
+      __m256i high = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(even, odd), compact);
+      uint8_t* out = segments + seg * s_segment_bytes; // NOLINT(build/unsigned)
+      store_segment(out, _mm256_castsi256_si128(low), false);
+      store_segment(out + s_segment_bytes, _mm256_castsi256_si128(high), false);
+      store_segment(out + 2 * s_segment_bytes, _mm256_extracti128_si256(low, 1), false);
+      store_segment(out + 3 * s_segment_bytes, _mm256_extracti128_si256(high, 1), seg + 3 == s_num_segments - 1);
+    }
+  }
+}
+
+#undef DATAFORMATS_WIBPACK_COMPACT
+
+#endif // DATAFORMATS_WIBUNPACK_X86
+
+using unpack_function_t = void (*)(const WIBFrame&, adc_t*) noexcept;
+
+unpack_function_t
+get_unpack_function(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+#ifdef DATAFORMATS_WIBUNPACK_X86
+    case UnpackImplementation::kAVX2:
+      return unpack_frame_avx2;
+    case UnpackImplementation::kSSSE3:
+      return unpack_frame_ssse3;
+#endif
+    default:
+      return unpack_frame_scalar;
+  }
+}
+
+using pack_function_t = void (*)(const adc_t*, WIBFrame&) noexcept;
+
+pack_function_t
+get_pack_function(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+#ifdef DATAFORMATS_WIBUNPACK_X86
+    case UnpackImplementation::kAVX2:
+      return pack_frame_avx2;
+    case UnpackImplementation::kSSSE3:
+      return pack_frame_ssse3;
+#endif
+    default:
+      return pack_frame_scalar;
+  }
+}
+
+void
+pack_frames_with(pack_function_t pack, const adc_t* adcs, WIBFrame* frames, size_t num_frames) noexcept
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    pack(adcs + i * WIBFrame::s_num_ch_per_frame, frames[i]);
+  }
+}
+
+void
+unpack_frames_with(unpack_function_t unpack, const WIBFrame* frames, size_t num_frames, adc_t* adcs) noexcept
+{
+  for (size_t i = 0; i < num_frames; ++i) {
+    unpack(frames[i], adcs + i * WIBFrame::s_num_ch_per_frame);
+  }
+}
+
+} // namespace
+
+const char*
+get_unpack_implementation_name(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+    case UnpackImplementation::kScalar:
+      return "scalar";
+    case UnpackImplementation::kSSSE3:
+      return "SSSE3";
+    case UnpackImplementation::kAVX2:
+      return "AVX2";
+  }
+  return "unknown";
+}
+
+bool
+is_unpack_implementation_supported(UnpackImplementation implementation) noexcept
+{
+  switch (implementation) {
+    case UnpackImplementation::kScalar:
+      return true;
+#ifdef DATAFORMATS_WIBUNPACK_X86
+    case UnpackImplementation::kSSSE3:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("ssse3");
+    case UnpackImplementation::kAVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+UnpackImplementation
+get_best_unpack_implementation() noexcept
+{
+  static const UnpackImplementation best = [] {
+    for (auto implementation : { UnpackImplementation::kAVX2, UnpackImplementation::kSSSE3 }) {
+      if (is_unpack_implementation_supported(implementation)) {
+        return implementation;
+      }
+    }
+    return UnpackImplementation::kScalar;
+  }();
+  return best;
+}
+
+void
+unpack_frames(const WIBFrame* frames, size_t num_frames, adc_t* adcs) noexcept
+{
+  static const unpack_function_t unpack = get_unpack_function(get_best_unpack_implementation());
+  unpack_frames_with(unpack, frames, num_frames, adcs);
+}
+
+void
+unpack_frames(const WIBFrame* frames, size_t num_frames, adc_t* adcs, UnpackImplementation implementation)
+{
+  if (!is_unpack_implementation_supported(implementation)) {
+    throw WIBUnpackImplementationUnsupported(ERS_HERE, get_unpack_implementation_name(implementation));
+  }
+  unpack_frames_with(get_unpack_function(implementation), frames, num_frames, adcs);
+}
+
+void
+pack_frames(const adc_t* adcs, WIBFrame* frames, size_t num_frames) noexcept
+{
+  static const pack_function_t pack = get_pack_function(get_best_unpack_implementation());
+  pack_frames_with(pack, adcs, frames, num_frames);
+}
+
+void
+pack_frames(const adc_t* adcs, WIBFrame* frames, size_t num_frames, UnpackImplementation implementation)
+{
+  if (!is_unpack_implementation_supported(implementation)) {
+    throw WIBUnpackImplementationUnsupported(ERS_HERE, get_unpack_implementation_name(implementation));
+  }
+  pack_frames_with(get_pack_function(implementation), adcs, frames, num_frames);
+}
+
+} // namespace dunedaq::dataformats::wib
@@ -0,0 +1,77 @@
+/**
+ * @file crc20_benchmark.cxx  Measure the throughput of the CRC20 of WIB2 and DAPHNE frames
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/CRC20.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+template<typename Frame>
+bool
+benchmark(const std::string& name, size_t iterations)
+{
+  constexpr size_t num_frames = 8192;
+  std::vector<Frame> frames(num_frames);
+  std::vector<typename Frame::Trailer> trailers(num_frames);
+  uint32_t state = 12345; // NOLINT(build/unsigned)
+  auto* bytes = reinterpret_cast<uint8_t*>(frames.data()); // NOLINT
+  for (size_t i = 0; i < num_frames * sizeof(Frame); ++i) {
+    state = state * 1664525 + 1013904223;
+    bytes[i] = state >> 24;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    fill_crc20(frames.data(), num_frames, trailers.data());
+  }
+  std::chrono::duration<double> fill = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  uint64_t crc_sum = 0; // NOLINT(build/unsigned)
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    for (size_t i = 0; i < num_frames; ++i) {
+      crc_sum += compute_crc20(frames[i]);
+    }
+  }
+  std::chrono::duration<double> compute = std::chrono::steady_clock::now() - start;
+
+  double bits = static_cast<double>(iterations * num_frames * sizeof(Frame) * 8);
+  std::cout << name << " fill   : " << iterations * num_frames / fill.count() << " frames per second, "
+            << bits / fill.count() / 1e9 << " Gb/s" << std::endl;
+  std::cout << name << " compute: " << iterations * num_frames / compute.count() << " frames per second, "
+            << bits / compute.count() / 1e9 << " Gb/s" << std::endl;
+
+  uint64_t trailer_sum = 0; // NOLINT(build/unsigned)
+  for (size_t i = 0; i < num_frames; ++i) {
+    trailer_sum += trailers[i].crc20;
+  }
+  if (crc_sum != trailer_sum * iterations) {
+    std::cout << "Computed CRC20s of " << name << " frames do not match the filled trailers" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+  bool ok = benchmark<WIB2Frame>("WIB2  ", iterations);
+  ok &= benchmark<DAPHNEFrame>("DAPHNE", iterations);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file frame_accessor_benchmark.cxx  Compare the checked and unchecked channel accessors of the frame classes
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/daphne/DAPHNEFrame.hpp"
+#include "dataformats/wib/WIBFrame.hpp"
+#include "dataformats/wib2/WIB2Frame.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Make a channel map: every channel of a frame, in a shuffled order, as offline code reading channels in
+ * detector order would use. The indices are only known at run time, so the compiler cannot remove range checks
+ * @param num_channels Number of channels per frame
+ * @return Channel indices
+ */
+std::vector<int>
+make_channel_map(int num_channels)
+{
+  std::vector<int> channel_map(num_channels);
+  std::iota(channel_map.begin(), channel_map.end(), 0);
+  std::shuffle(channel_map.begin(), channel_map.end(), std::mt19937(42));
+  return channel_map;
+}
+
+/**
+ * @brief Time a per-channel loop over a set of frames
+ * @param name Label to print
+ * @param frames Frames to read
+ * @param iterations Number of passes over the frames
+ * @param sum_frame Function returning the sum of all channels of one frame
+ * @return Sum of all values read, so that the loop is not optimized away
+ */
+template<typename Frame, typename Func>
+uint64_t // NOLINT(build/unsigned)
+time_it(const std::string& name, const std::vector<Frame>& frames, size_t iterations, Func&& sum_frame)
+{
+  uint64_t checksum = 0; // NOLINT(build/unsigned)
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    for (auto& frame : frames) {
+      checksum += sum_frame(frame);
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << name << ": " << iterations * frames.size() / elapsed.count() << " frames per second" << std::endl;
+  return checksum;
+}
+
+/**
+ * @brief Create frames filled with pseudo-random ADC values
+ * @param num_frames Number of frames
+ * @param num_channels Number of channels per frame
+ * @param set_channel Function setting one channel of a frame
+ * @return The frames
+ */
+template<typename Frame, typename Func>
+std::vector<Frame>
+make_frames(size_t num_frames, int num_channels, Func&& set_channel)
+{
+  std::vector<Frame> frames(num_frames);
+  uint32_t state = 12345; // NOLINT(build/unsigned)
+  for (auto& frame : frames) {
+    std::memset(&frame, 0, sizeof(frame));
+    for (int ch = 0; ch < num_channels; ++ch) {
+      state = state * 1664525 + 1013904223;
+      set_channel(frame, ch, state >> 20);
+    }
+  }
+  return frames;
+}
+
+/**
+ * @brief Compare a checked and an unchecked accessor, reading every channel of every frame through a channel map
+ * @param name Name of the frame class
+ * @param frames Frames to read
+ * @param num_channels Number of channels per frame
+ * @param iterations Number of passes over the frames
+ * @param checked Checked accessor, called as checked(frame, channel)
+ * @param unchecked Unchecked accessor, called as unchecked(frame, channel)
+ * @return Whether both accessors returned the same values
+ */
+template<typename Frame, typename Checked, typename Unchecked>
+bool
+benchmark(const std::string& name,
+          const std::vector<Frame>& frames,
+          int num_channels,
+          size_t iterations,
+          Checked&& checked,
+          Unchecked&& unchecked)
+{
+  auto channel_map = make_channel_map(num_channels);
+  auto checked_sum = time_it(name + " checked  ", frames, iterations, [&](const Frame& frame) {
+    uint32_t sum = 0; // NOLINT(build/unsigned)
+    for (int ch : channel_map) {
+      sum += checked(frame, ch);
+    }
+    return sum;
+  });
+  auto unchecked_sum = time_it(name + " unchecked", frames, iterations, [&](const Frame& frame) {
+    uint32_t sum = 0; // NOLINT(build/unsigned)
+    for (int ch : channel_map) {
+      sum += unchecked(frame, ch);
+    }
+    return sum;
+  });
+  return checked_sum == unchecked_sum;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+  constexpr size_t num_frames = 1000;
+  bool agree = true;
+
+  auto wib_frames = make_frames<WIBFrame>(
+    num_frames, WIBFrame::s_num_ch_per_frame, [](WIBFrame& f, int ch, uint16_t val) { f.set_channel(ch, val); });
+  agree &= benchmark(
+    "WIBFrame   ",
+    wib_frames,
+    WIBFrame::s_num_ch_per_frame,
+    iterations,
+    [](const WIBFrame& f, int ch) { return f.get_channel(ch); },
+    [](const WIBFrame& f, int ch) { return f.get_channel_unchecked(ch); });
+
+  auto wib2_frames = make_frames<WIB2Frame>(
+    num_frames, WIB2Frame::s_num_channels, [](WIB2Frame& f, int ch, uint16_t val) { f.set_adc(ch, val & 0x3FFF); });
+  agree &= benchmark(
+    "WIB2Frame  ",
+    wib2_frames,
+    WIB2Frame::s_num_channels,
+    iterations,
+    [](const WIB2Frame& f, int ch) { return f.get_adc(ch); },
+    [](const WIB2Frame& f, int ch) { return f.get_adc_unchecked(ch); });
+
+  auto daphne_frames = make_frames<DAPHNEFrame>(
+    num_frames, DAPHNEFrame::s_num_channels, [](DAPHNEFrame& f, int ch, uint16_t val) { f.set_adc(ch, val & 0x3FFF); });
+  agree &= benchmark(
+    "DAPHNEFrame",
+    daphne_frames,
+    DAPHNEFrame::s_num_channels,
+    iterations,
+    [](const DAPHNEFrame& f, int ch) { return f.get_adc(ch); },
+    [](const DAPHNEFrame& f, int ch) { return f.get_adc_unchecked(ch); });
+
+  if (!agree) {
+    std::cout << "Checked and unchecked accessors disagree" << std::endl;
+    return 1;
+  }
+  return 0;
+}
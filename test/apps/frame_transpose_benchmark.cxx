@@ -0,0 +1,176 @@
+/**
+ * @file frame_transpose_benchmark.cxx  Compare the channel-major transposes with per-value accessor loops
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/FrameTranspose.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Time a conversion
+ * @param name Label to print
+ * @param iterations Number of conversions
+ * @param num_frames Number of frames per conversion
+ * @param convert Function converting every frame
+ * @return Frames converted per second
+ */
+template<typename Func>
+double
+time_it(const std::string& name, size_t iterations, size_t num_frames, Func&& convert)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    convert();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double rate = iterations * num_frames / elapsed.count();
+  std::cout << name << ": " << rate << " frames per second" << std::endl;
+  return rate;
+}
+
+/**
+ * @brief Compare a per-value loop, writing one channel row at a time, with transpose_to_channel_major()
+ * @param name Name of the frame class
+ * @param frames Frames to convert
+ * @param num_channels Number of channels per frame
+ * @param iterations Number of conversions
+ * @param get Per-value accessor, called as get(frame, channel)
+ * @return Whether both conversions gave the same array
+ */
+template<typename Frame, typename Get>
+bool
+benchmark(const std::string& name, const std::vector<Frame>& frames, int num_channels, size_t iterations, Get&& get)
+{
+  const size_t num_frames = frames.size();
+  const size_t row_stride = get_channel_major_row_stride(num_frames);
+  std::vector<uint16_t> naive(num_channels * row_stride);      // NOLINT(build/unsigned)
+  std::vector<uint16_t> transposed(num_channels * row_stride); // NOLINT(build/unsigned)
+
+  double reference = time_it(name + " per-value loop", iterations, num_frames, [&]() {
+    for (int ch = 0; ch < num_channels; ++ch) {
+      for (size_t tick = 0; tick < num_frames; ++tick) {
+        naive[ch * row_stride + tick] = get(frames[tick], ch);
+      }
+    }
+  });
+  double rate = time_it(name + " transpose     ", iterations, num_frames, [&]() {
+    transpose_to_channel_major(frames.data(), num_frames, transposed.data(), row_stride);
+  });
+  std::cout << "  speed-up: " << rate / reference << std::endl;
+  return naive == transposed;
+}
+
+/**
+ * @brief Create frames filled with pseudo-random bytes
+ */
+template<typename Frame>
+std::vector<Frame>
+make_frames(size_t num_frames)
+{
+  std::vector<Frame> frames(num_frames);
+  uint32_t state = 12345; // NOLINT(build/unsigned)
+  auto* bytes = reinterpret_cast<uint8_t*>(frames.data()); // NOLINT
+  for (size_t i = 0; i < num_frames * sizeof(Frame); ++i) {
+    state = state * 1664525 + 1013904223;
+    bytes[i] = state >> 24;
+  }
+  return frames;
+}
+
+/**
+ * @brief Compare a loop over get_u, get_v and get_x with transpose_to_planes()
+ * @return Whether both gave the same arrays
+ */
+bool
+benchmark_planes(const std::vector<WIB2Frame>& frames, size_t iterations)
+{
+  const size_t num_frames = frames.size();
+  const size_t row_stride = get_channel_major_row_stride(num_frames);
+  constexpr int num_u = WIB2Frame::s_u_channels_per_femb;
+  constexpr int num_v = WIB2Frame::s_v_channels_per_femb;
+  constexpr int num_x = WIB2Frame::s_x_channels_per_femb;
+  std::vector<int16_t> pedestals(WIB2Frame::s_num_channels);
+  for (size_t ch = 0; ch < pedestals.size(); ++ch) {
+    pedestals[ch] = 500 + 7 * ch;
+  }
+  std::vector<int16_t> naive(WIB2Frame::s_num_channels * row_stride);
+  std::vector<int16_t> fused(WIB2Frame::s_num_channels * row_stride);
+  auto split = [&](std::vector<int16_t>& adcs) {
+    int16_t* u = adcs.data();
+    int16_t* v = u + 2 * num_u * row_stride;
+    int16_t* x = v + 2 * num_v * row_stride;
+    return std::make_tuple(u, v, x);
+  };
+
+  double reference = time_it("WIB2Frame planes per-value loop", iterations, num_frames, [&]() {
+    auto [u, v, x] = split(naive);
+    for (int femb = 0; femb < WIB2Frame::s_fembs_per_frame; ++femb) {
+      const int16_t* femb_pedestals = pedestals.data() + femb * WIB2Frame::s_channels_per_femb;
+      for (int i = 0; i < num_u; ++i) {
+        for (size_t tick = 0; tick < num_frames; ++tick) {
+          u[(femb * num_u + i) * row_stride + tick] = frames[tick].get_u(femb, i) - femb_pedestals[i];
+        }
+      }
+      for (int i = 0; i < num_v; ++i) {
+        for (size_t tick = 0; tick < num_frames; ++tick) {
+          v[(femb * num_v + i) * row_stride + tick] = frames[tick].get_v(femb, i) - femb_pedestals[num_u + i];
+        }
+      }
+      for (int i = 0; i < num_x; ++i) {
+        for (size_t tick = 0; tick < num_frames; ++tick) {
+          x[(femb * num_x + i) * row_stride + tick] = frames[tick].get_x(femb, i) - femb_pedestals[num_u + num_v + i];
+        }
+      }
+    }
+  });
+  double rate = time_it("WIB2Frame planes transpose     ", iterations, num_frames, [&]() {
+    auto [u, v, x] = split(fused);
+    transpose_to_planes(frames.data(), num_frames, pedestals.data(), u, v, x, row_stride);
+  });
+  std::cout << "  speed-up: " << rate / reference << std::endl;
+  return naive == fused;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+  // A few ms of data, more than fits in the L2 cache
+  constexpr size_t num_frames = 8192;
+  bool agree = true;
+
+  agree &= benchmark("WIBFrame ",
+                     make_frames<WIBFrame>(num_frames),
+                     WIBFrame::s_num_ch_per_frame,
+                     iterations,
+                     [](const WIBFrame& f, int ch) { return f.get_channel(ch); });
+  agree &= benchmark("WIB2Frame",
+                     make_frames<WIB2Frame>(num_frames),
+                     WIB2Frame::s_num_channels,
+                     iterations,
+                     [](const WIB2Frame& f, int ch) { return f.get_adc(ch); });
+  agree &= benchmark_planes(make_frames<WIB2Frame>(num_frames), iterations);
+
+  if (!agree) {
+    std::cout << "The per-value loop and the transpose disagree" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file json_writer_benchmark.cxx  Compare JsonWriter with the stream operators of the header structs
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/JsonWriter.hpp"
+#include "dataformats/TriggerRecordHeaderData.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Time a function over a number of iterations
+ * @param name Label to print
+ * @param iterations Number of times to call func
+ * @param func Function to time, called with the iteration number
+ */
+template<typename Func>
+void
+time_it(const std::string& name, size_t iterations, Func&& func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t idx = 0; idx < iterations; ++idx) {
+    func(idx);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << name << ": " << iterations / elapsed.count() << " records per second" << std::endl;
+}
+
+/**
+ * @brief Benchmark the stream operator against JsonWriter for one struct type
+ * @param name Name of the struct type
+ * @param value Instance to write, whose trigger_number is changed on every iteration
+ * @param iterations Number of iterations of each measurement
+ */
+template<typename T>
+void
+benchmark(const std::string& name, T value, size_t iterations)
+{
+  size_t checksum = 0;
+
+  time_it(name + " operator<< ", iterations, [&](size_t idx) {
+    value.trigger_number = idx;
+    std::ostringstream ostr;
+    ostr << value << '\n';
+    checksum += ostr.str().size();
+  });
+
+  JsonWriter writer;
+  time_it(name + " JsonWriter ", iterations, [&](size_t idx) {
+    value.trigger_number = idx;
+    writer.clear();
+    writer.write(value).newline();
+    checksum += writer.size();
+  });
+
+  std::cout << name << " checksum: " << checksum << std::endl;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  FragmentHeader fragment_header;
+  fragment_header.size = 4096;
+  fragment_header.trigger_timestamp = 98765432109876;
+  fragment_header.window_begin = 98765432108876;
+  fragment_header.window_end = 98765432110876;
+  fragment_header.run_number = 42;
+  fragment_header.fragment_type = static_cast<fragment_type_t>(FragmentType::kTPCData);
+  fragment_header.sequence_number = 0;
+  fragment_header.element_id = GeoID(GeoID::SystemType::kTPC, 3, 127);
+  benchmark("FragmentHeader", fragment_header, iterations);
+
+  TriggerRecordHeaderData trigger_record_header;
+  trigger_record_header.trigger_timestamp = 98765432109876;
+  trigger_record_header.run_number = 42;
+  trigger_record_header.trigger_type = 1;
+  trigger_record_header.num_requested_components = 150;
+  trigger_record_header.sequence_number = 0;
+  trigger_record_header.max_sequence_number = 0;
+  benchmark("TriggerRecordHeaderData", trigger_record_header, iterations);
+
+  return 0;
+}
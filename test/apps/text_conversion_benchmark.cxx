@@ -0,0 +1,113 @@
+/**
+ * @file text_conversion_benchmark.cxx  Compare to_chars/from_chars with the stream operators of the header structs
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/ComponentRequest.hpp"
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/GeoID.hpp"
+#include "dataformats/TriggerRecordHeaderData.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Time a function over a number of iterations
+ * @param name Label to print
+ * @param iterations Number of times to call func
+ * @param func Function to time, called with the iteration number
+ */
+template<typename Func>
+void
+time_it(const std::string& name, size_t iterations, Func&& func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t idx = 0; idx < iterations; ++idx) {
+    func(idx);
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << name << ": " << elapsed.count() / iterations << " ns per call" << std::endl;
+}
+
+/**
+ * @brief Benchmark formatting and parsing of one struct type
+ * @param name Name of the struct type
+ * @param value Instance to format and parse
+ * @param iterations Number of iterations of each measurement
+ */
+template<typename T>
+void
+benchmark(const std::string& name, T value, size_t iterations)
+{
+  size_t checksum = 0;
+  char buffer[512];
+
+  time_it(name + " operator<<", iterations, [&](size_t) {
+    std::ostringstream ostr;
+    ostr << value;
+    checksum += ostr.str().size();
+  });
+  time_it(name + " to_chars  ", iterations, [&](size_t) {
+    auto res = to_chars(buffer, buffer + sizeof(buffer), value);
+    checksum += res.ptr - buffer;
+  });
+
+  std::ostringstream ostr;
+  ostr << value;
+  std::string text = ostr.str();
+
+  time_it(name + " operator>>", iterations, [&](size_t) {
+    std::istringstream istr(text);
+    T parsed;
+    istr >> parsed;
+    checksum += istr.good();
+  });
+  time_it(name + " from_chars", iterations, [&](size_t) {
+    T parsed;
+    auto res = from_chars(text.data(), text.data() + text.size(), parsed);
+    checksum += res.ec == std::errc();
+  });
+
+  std::cout << name << " checksum: " << checksum << std::endl;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+  GeoID id(GeoID::SystemType::kTPC, 3, 127);
+  benchmark("GeoID", id, iterations);
+
+  benchmark("ComponentRequest", ComponentRequest(id, 1000000000, 1000002000), iterations);
+
+  FragmentHeader fragment_header;
+  fragment_header.size = 4096;
+  fragment_header.trigger_number = 123456;
+  fragment_header.trigger_timestamp = 98765432109876;
+  fragment_header.run_number = 42;
+  fragment_header.element_id = id;
+  benchmark("FragmentHeader", fragment_header, iterations);
+
+  TriggerRecordHeaderData trigger_record_header;
+  trigger_record_header.trigger_number = 123456;
+  trigger_record_header.trigger_timestamp = 98765432109876;
+  trigger_record_header.run_number = 42;
+  trigger_record_header.num_requested_components = 150;
+  benchmark("TriggerRecordHeaderData", trigger_record_header, iterations);
+
+  return 0;
+}
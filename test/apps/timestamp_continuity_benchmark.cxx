@@ -0,0 +1,104 @@
+/**
+ * @file timestamp_continuity_benchmark.cxx  Measure the frame rate of the timestamp continuity checker
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/TimestampContinuity.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Compare a per-frame loop classifying every step with check_timestamp_continuity()
+ * @param name Name of the frame class
+ * @param frames Frames to check
+ * @param iterations Number of passes over the frames
+ * @return Whether both found the same number of discontinuities
+ */
+template<typename Frame>
+bool
+benchmark(const std::string& name, const std::vector<Frame>& frames, size_t iterations)
+{
+  const timestamp_t step = FrameTimestampStep<Frame>::value;
+  size_t naive_count = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    TimestampContinuityReport report;
+    report.first_discontinuity = frames.size();
+    for (size_t i = 1; i < frames.size(); ++i) {
+      if (frames[i].get_timestamp() != frames[i - 1].get_timestamp() + step) {
+        report.add(i, frames[i - 1].get_timestamp(), frames[i].get_timestamp(), step);
+      }
+    }
+    naive_count += report.num_gaps;
+  }
+  std::chrono::duration<double> naive = std::chrono::steady_clock::now() - start;
+
+  size_t count = 0;
+  start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    count += check_timestamp_continuity(frames.data(), frames.size()).num_gaps;
+  }
+  std::chrono::duration<double> checker = std::chrono::steady_clock::now() - start;
+
+  double frames_checked = static_cast<double>(iterations * frames.size());
+  std::cout << name << " per-frame loop: " << frames_checked / naive.count() << " frames per second" << std::endl;
+  std::cout << name << " checker       : " << frames_checked / checker.count() << " frames per second ("
+            << frames_checked * sizeof(Frame) * 8 / checker.count() / 1e9 << " Gb/s)" << std::endl;
+  return count == naive_count;
+}
+
+/**
+ * @brief Make frames at the nominal step, with one gap
+ */
+template<typename Frame, typename SetTimestamp>
+std::vector<Frame>
+make_frames(size_t num_frames, SetTimestamp&& set_timestamp)
+{
+  std::vector<Frame> frames(num_frames);
+  std::memset(frames.data(), 0, num_frames * sizeof(Frame));
+  for (size_t i = 0; i < num_frames; ++i) {
+    set_timestamp(frames[i], 1000000 + (i + (i > num_frames / 2)) * FrameTimestampStep<Frame>::value);
+  }
+  return frames;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+  // About one readout request worth of frames
+  constexpr size_t num_frames = 8192;
+  bool agree = true;
+
+  agree &= benchmark(
+    "WIBFrame ",
+    make_frames<WIBFrame>(num_frames, [](WIBFrame& f, timestamp_t ts) { f.set_timestamp(ts); }),
+    iterations);
+  agree &= benchmark("WIB2Frame",
+                     make_frames<WIB2Frame>(num_frames,
+                                            [](WIB2Frame& f, timestamp_t ts) {
+                                              f.header.timestamp_1 = ts;
+                                              f.header.timestamp_2 = ts >> 32;
+                                            }),
+                     iterations);
+
+  if (!agree) {
+    std::cout << "The per-frame loop and the checker disagree" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file wib2_unpack_benchmark.cxx  Compare the bulk WIB2Frame unpacker and packer with get_adc and set_adc loops
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib2/WIB2Unpack.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Time a decoder over a set of frames
+ * @param name Label to print
+ * @param iterations Number of passes over the frames
+ * @param num_frames Number of frames decoded per pass
+ * @param decode Function decoding every frame
+ * @return Frames decoded per second
+ */
+template<typename Func>
+double
+time_it(const std::string& name, size_t iterations, size_t num_frames, Func&& decode)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    decode();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double rate = iterations * num_frames / elapsed.count();
+  std::cout << name << ": " << rate << " frames per second" << std::endl;
+  return rate;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+  constexpr size_t num_frames = 1000;
+
+  std::vector<WIB2Frame> frames(num_frames);
+  uint32_t state = 12345; // NOLINT(build/unsigned)
+  auto* bytes = reinterpret_cast<uint8_t*>(frames.data()); // NOLINT
+  for (size_t i = 0; i < num_frames * sizeof(WIB2Frame); ++i) {
+    state = state * 1664525 + 1013904223;
+    bytes[i] = state >> 24;
+  }
+
+  std::vector<uint16_t> expected(num_frames * WIB2Frame::s_num_channels); // NOLINT(build/unsigned)
+  double reference = time_it("get_adc loop", iterations, num_frames, [&]() {
+    for (size_t i = 0; i < num_frames; ++i) {
+      for (int ch = 0; ch < WIB2Frame::s_num_channels; ++ch) {
+        expected[i * WIB2Frame::s_num_channels + ch] = frames[i].get_adc(ch);
+      }
+    }
+  });
+
+  bool agree = true;
+  for (auto implementation : { wib2::UnpackImplementation::kScalar,
+                               wib2::UnpackImplementation::kAVX2,
+                               wib2::UnpackImplementation::kAVX512VBMI }) {
+    std::string name = wib2::get_unpack_implementation_name(implementation);
+    if (!wib2::is_unpack_implementation_supported(implementation)) {
+      std::cout << name << ": not supported by this CPU" << std::endl;
+      continue;
+    }
+    std::vector<uint16_t> adcs(expected.size()); // NOLINT(build/unsigned)
+    double rate = time_it(name + " unpack_frames", iterations, num_frames, [&]() {
+      wib2::unpack_frames(frames.data(), num_frames, adcs.data(), implementation);
+    });
+    std::cout << "  speed-up over get_adc: " << rate / reference << std::endl;
+    agree &= adcs == expected;
+  }
+
+  std::vector<WIB2Frame> packed(num_frames);
+  reference = time_it("set_adc loop", iterations, num_frames, [&]() {
+    for (size_t i = 0; i < num_frames; ++i) {
+      for (int ch = 0; ch < WIB2Frame::s_num_channels; ++ch) {
+        packed[i].set_adc(ch, expected[i * WIB2Frame::s_num_channels + ch]);
+      }
+    }
+  });
+  auto same_adcs = [&]() {
+    for (size_t i = 0; i < num_frames; ++i) {
+      if (std::memcmp(packed[i].adc_words, frames[i].adc_words, sizeof(frames[i].adc_words)) != 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+  agree &= same_adcs();
+
+  for (auto implementation : { wib2::UnpackImplementation::kScalar,
+                               wib2::UnpackImplementation::kAVX2,
+                               wib2::UnpackImplementation::kAVX512VBMI }) {
+    if (!wib2::is_unpack_implementation_supported(implementation)) {
+      continue;
+    }
+    std::memset(packed.data(), 0, num_frames * sizeof(WIB2Frame));
+    double rate = time_it(std::string(wib2::get_unpack_implementation_name(implementation)) + " pack_frames",
+                          iterations,
+                          num_frames,
+                          [&]() { wib2::pack_frames(expected.data(), packed.data(), num_frames, implementation); });
+    std::cout << "  speed-up over set_adc: " << rate / reference << std::endl;
+    agree &= same_adcs();
+  }
+
+  if (!agree) {
+    std::cout << "The bulk and per-channel methods disagree" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file wib_checksum_benchmark.cxx  Measure the throughput of COLDATA checksum verification
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBChecksum.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+  constexpr size_t num_frames = 8192;
+
+  std::vector<WIBFrame> frames(num_frames);
+  uint32_t state = 12345; // NOLINT(build/unsigned)
+  auto* bytes = reinterpret_cast<uint8_t*>(frames.data()); // NOLINT
+  for (size_t i = 0; i < num_frames * sizeof(WIBFrame); ++i) {
+    state = state * 1664525 + 1013904223;
+    bytes[i] = state >> 24;
+  }
+  // Frames of one readout link
+  for (auto& frame : frames) {
+    frame.get_wib_header()->crate_no = 1;
+    frame.get_wib_header()->slot_no = 2;
+    frame.get_wib_header()->fiber_no = 1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    wib::fill_coldata_checksums(frames.data(), num_frames);
+  }
+  std::chrono::duration<double> fill = std::chrono::steady_clock::now() - start;
+
+  wib::ColdataChecksumSummary summary;
+  start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    summary.add(frames.data(), num_frames);
+  }
+  std::chrono::duration<double> verify = std::chrono::steady_clock::now() - start;
+
+  double bits = static_cast<double>(iterations * num_frames * sizeof(WIBFrame) * 8);
+  std::cout << "fill  : " << iterations * num_frames / fill.count() << " frames per second, "
+            << bits / fill.count() / 1e9 << " Gb/s" << std::endl;
+  std::cout << "verify: " << iterations * num_frames / verify.count() << " frames per second, "
+            << bits / verify.count() / 1e9 << " Gb/s" << std::endl;
+
+  auto total = summary.get_total();
+  if (total.num_frames != iterations * num_frames || total.num_bad_frames != 0) {
+    std::cout << "Unexpected checksum mismatches after filling" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file wib_error_scan_benchmark.cxx  Measure the throughput of the WIB header error scan
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBErrorScan.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+  constexpr size_t num_frames = 8192;
+
+  // Frames of one readout link, with no error field set but for one frame in 4096
+  std::vector<WIBFrame> frames(num_frames);
+  std::memset(frames.data(), 0, num_frames * sizeof(WIBFrame));
+  for (size_t i = 0; i < num_frames; ++i) {
+    frames[i].get_wib_header()->crate_no = 1;
+    frames[i].get_wib_header()->slot_no = 2;
+    frames[i].get_wib_header()->fiber_no = 1;
+    frames[i].set_timestamp(i * 25);
+    for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+      frames[i].set_channel(ch, (i + ch) & 0xFFF);
+    }
+  }
+  for (size_t i = 0; i < num_frames; i += 4096) {
+    frames[i].get_coldata_header(1)->error_register = 0x1;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    wib::WIBErrorCounts counts;
+    for (size_t i = 0; i < num_frames; ++i) {
+      counts.add(frames[i]);
+    }
+    if (counts.num_frames_with_errors != num_frames / 4096) {
+      std::cout << "Unexpected frame-by-frame error count" << std::endl;
+      return 1;
+    }
+  }
+  std::chrono::duration<double> reference = std::chrono::steady_clock::now() - start;
+
+  wib::WIBErrorSummary summary;
+  start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    summary.add(frames.data(), num_frames);
+  }
+  std::chrono::duration<double> scan = std::chrono::steady_clock::now() - start;
+
+  double bits = static_cast<double>(iterations * num_frames * sizeof(WIBFrame) * 8);
+  std::cout << "frame by frame: " << iterations * num_frames / reference.count() << " frames per second, "
+            << bits / reference.count() / 1e9 << " Gb/s" << std::endl;
+  std::cout << "scan          : " << iterations * num_frames / scan.count() << " frames per second, "
+            << bits / scan.count() / 1e9 << " Gb/s" << std::endl;
+
+  auto total = summary.get_total();
+  if (total.num_frames != iterations * num_frames || total.num_frames_with_errors != iterations * num_frames / 4096) {
+    std::cout << "Unexpected error counts" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file wib_unpack_benchmark.cxx  Compare the bulk WIBFrame unpacker and packer with get_channel and set_channel loops
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBUnpack.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Time a decoder over a set of frames
+ * @param name Label to print
+ * @param iterations Number of passes over the frames
+ * @param num_frames Number of frames decoded per pass
+ * @param decode Function decoding every frame
+ * @return Frames decoded per second
+ */
+template<typename Func>
+double
+time_it(const std::string& name, size_t iterations, size_t num_frames, Func&& decode)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t iter = 0; iter < iterations; ++iter) {
+    decode();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double rate = iterations * num_frames / elapsed.count();
+  std::cout << name << ": " << rate << " frames per second" << std::endl;
+  return rate;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+  constexpr size_t num_frames = 1000;
+
+  std::vector<WIBFrame> frames(num_frames);
+  uint32_t state = 12345; // NOLINT(build/unsigned)
+  for (auto& frame : frames) {
+    std::memset(&frame, 0, sizeof(frame));
+    for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+      state = state * 1664525 + 1013904223;
+      frame.set_channel(ch, state >> 20);
+    }
+  }
+
+  std::vector<adc_t> expected(num_frames * WIBFrame::s_num_ch_per_frame);
+  double reference = time_it("get_channel loop", iterations, num_frames, [&]() {
+    for (size_t i = 0; i < num_frames; ++i) {
+      for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+        expected[i * WIBFrame::s_num_ch_per_frame + ch] = frames[i].get_channel(ch);
+      }
+    }
+  });
+
+  bool agree = true;
+  for (auto implementation :
+       { wib::UnpackImplementation::kScalar, wib::UnpackImplementation::kSSSE3, wib::UnpackImplementation::kAVX2 }) {
+    std::string name = wib::get_unpack_implementation_name(implementation);
+    if (!wib::is_unpack_implementation_supported(implementation)) {
+      std::cout << name << ": not supported by this CPU" << std::endl;
+      continue;
+    }
+    std::vector<adc_t> adcs(expected.size());
+    double rate = time_it(name + " unpack_frames", iterations, num_frames, [&]() {
+      wib::unpack_frames(frames.data(), num_frames, adcs.data(), implementation);
+    });
+    std::cout << "  speed-up over get_channel: " << rate / reference << std::endl;
+    agree &= adcs == expected;
+  }
+
+  std::vector<WIBFrame> packed(num_frames);
+  std::memset(packed.data(), 0, num_frames * sizeof(WIBFrame));
+  reference = time_it("set_channel loop", iterations, num_frames, [&]() {
+    for (size_t i = 0; i < num_frames; ++i) {
+      for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+        packed[i].set_channel(ch, expected[i * WIBFrame::s_num_ch_per_frame + ch]);
+      }
+    }
+  });
+  agree &= std::memcmp(packed.data(), frames.data(), num_frames * sizeof(WIBFrame)) == 0;
+
+  for (auto implementation :
+       { wib::UnpackImplementation::kScalar, wib::UnpackImplementation::kSSSE3, wib::UnpackImplementation::kAVX2 }) {
+    if (!wib::is_unpack_implementation_supported(implementation)) {
+      continue;
+    }
+    std::memset(packed.data(), 0, num_frames * sizeof(WIBFrame));
+    double rate = time_it(std::string(wib::get_unpack_implementation_name(implementation)) + " pack_frames",
+                          iterations,
+                          num_frames,
+                          [&]() { wib::pack_frames(expected.data(), packed.data(), num_frames, implementation); });
+    std::cout << "  speed-up over set_channel: " << rate / reference << std::endl;
+    agree &= std::memcmp(packed.data(), frames.data(), num_frames * sizeof(WIBFrame)) == 0;
+  }
+
+  if (!agree) {
+    std::cout << "The bulk and per-channel methods disagree" << std::endl;
+    return 1;
+  }
+  return 0;
+}
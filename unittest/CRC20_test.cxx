@@ -0,0 +1,140 @@
+/**
+ * @file CRC20_test.cxx CRC20 of WIB2 and DAPHNE frames Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/CRC20.hpp"
+
+#include "RandomFrames.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE CRC20_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Bit-at-a-time CRC20, straight from the definition
+ */
+uint32_t // NOLINT(build/unsigned)
+reference_crc20(const uint8_t* bytes, size_t size) // NOLINT(build/unsigned)
+{
+  uint32_t crc = 0; // NOLINT(build/unsigned)
+  for (size_t i = 0; i < size; ++i) {
+    for (int bit = 7; bit >= 0; --bit) {
+      const uint32_t feedback = ((bytes[i] >> bit) ^ (crc >> 19)) & 1; // NOLINT(build/unsigned)
+      crc = ((crc << 1) & s_crc20_mask) ^ (feedback ? s_crc20_polynomial : 0);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief Count the frames whose trailer CRC20 differs from the CRC20 of their contents
+ */
+template<typename Frame>
+size_t
+count_crc20_mismatches(const std::vector<Frame>& frames, const std::vector<typename Frame::Trailer>& trailers)
+{
+  size_t num_mismatches = 0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    num_mismatches += compute_crc20(frames[i]) != trailers[i].crc20;
+  }
+  return num_mismatches;
+}
+
+template<typename Frame>
+void
+check_fill()
+{
+  auto frames = make_random_frames<Frame>(50, 97531);
+  std::vector<typename Frame::Trailer> trailers(frames.size());
+  for (auto& trailer : trailers) {
+    trailer.flex_word_12 = 0xABC;
+    trailer.eof = 0x3C;
+  }
+  fill_crc20(frames.data(), frames.size(), trailers.data());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(trailers[i].crc20,
+                        reference_crc20(reinterpret_cast<const uint8_t*>(&frames[i]), sizeof(Frame))); // NOLINT
+    BOOST_REQUIRE_EQUAL(trailers[i].flex_word_12, 0xABC);
+    BOOST_REQUIRE_EQUAL(trailers[i].eof, 0x3C);
+  }
+  BOOST_REQUIRE_EQUAL(count_crc20_mismatches(frames, trailers), 0);
+
+  frames[3].set_adc(17, frames[3].get_adc(17) ^ 0x1);
+  reinterpret_cast<uint8_t*>(&frames[41].header)[5] ^= 0x10; // NOLINT
+  BOOST_REQUIRE_EQUAL(count_crc20_mismatches(frames, trailers), 2);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(CRC20_test)
+
+BOOST_AUTO_TEST_CASE(MatchesReference)
+{
+  std::vector<uint8_t> bytes(1000); // NOLINT(build/unsigned)
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> byte(0, 0xFF);
+  for (auto& b : bytes) {
+    b = byte(gen);
+  }
+  BOOST_REQUIRE_EQUAL(compute_crc20(bytes.data(), 0), 0);
+  // Every tail length after the 8-byte steps
+  for (size_t size = 1; size < 100; ++size) {
+    BOOST_REQUIRE_EQUAL(compute_crc20(bytes.data() + size, size), reference_crc20(bytes.data() + size, size));
+  }
+  BOOST_REQUIRE_EQUAL(compute_crc20(bytes.data(), bytes.size()), reference_crc20(bytes.data(), bytes.size()));
+  BOOST_REQUIRE_LE(compute_crc20(bytes.data(), bytes.size()), s_crc20_mask);
+}
+
+BOOST_AUTO_TEST_CASE(Chaining)
+{
+  std::vector<uint8_t> bytes(333); // NOLINT(build/unsigned)
+  std::mt19937 gen(54321);
+  std::uniform_int_distribution<int> byte(0, 0xFF);
+  for (auto& b : bytes) {
+    b = byte(gen);
+  }
+  const uint32_t whole = compute_crc20(bytes.data(), bytes.size()); // NOLINT(build/unsigned)
+  for (size_t split : { 0, 1, 7, 8, 100, 332, 333 }) {
+    uint32_t crc = compute_crc20(bytes.data(), split); // NOLINT(build/unsigned)
+    BOOST_REQUIRE_EQUAL(compute_crc20(bytes.data() + split, bytes.size() - split, crc), whole);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DetectsSingleBitErrors)
+{
+  auto frame = make_random_frames<WIB2Frame>(1, 97531)[0];
+  const uint32_t crc = compute_crc20(frame); // NOLINT(build/unsigned)
+  auto* bytes = reinterpret_cast<uint8_t*>(&frame); // NOLINT
+  for (size_t bit = 0; bit < sizeof(frame) * 8; ++bit) {
+    bytes[bit / 8] ^= 1 << (bit % 8);
+    BOOST_REQUIRE_NE(compute_crc20(frame), crc);
+    bytes[bit / 8] ^= 1 << (bit % 8);
+  }
+  BOOST_REQUIRE_EQUAL(compute_crc20(frame), crc);
+}
+
+BOOST_AUTO_TEST_CASE(WIB2Frames)
+{
+  check_fill<WIB2Frame>();
+}
+
+BOOST_AUTO_TEST_CASE(DAPHNEFrames)
+{
+  check_fill<DAPHNEFrame>();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
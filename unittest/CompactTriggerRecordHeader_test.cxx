@@ -0,0 +1,180 @@
+/**
+ * @file CompactTriggerRecordHeader_test.cxx CompactTriggerRecordHeader class Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/CompactTriggerRecordHeader.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE CompactTriggerRecordHeader_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+BOOST_AUTO_TEST_SUITE(CompactTriggerRecordHeader_test)
+
+namespace {
+TriggerRecordHeader
+make_header(size_t num_components)
+{
+  TriggerRecordHeaderBuilder builder(num_components);
+  for (uint32_t i = 0; i < num_components; ++i) { // NOLINT(build/unsigned)
+    // Every tenth component gets its own window
+    if (i % 10 == 3) {
+      builder.emplace_back(GeoID(GeoID::SystemType::kTPC, i / 100, i), i, i + 1);
+    } else {
+      builder.emplace_back(GeoID(GeoID::SystemType::kTPC, i / 100, i), 1000, 2000);
+    }
+  }
+  auto header = builder.build();
+  header.set_run_number(9);
+  header.set_trigger_number(10);
+  header.set_trigger_timestamp(11);
+  header.set_trigger_type(12);
+  header.set_sequence_number(13);
+  header.set_max_sequence_number(14);
+  header.set_error_bit(TriggerRecordErrorBits::kMismatch, true);
+  return header;
+}
+} // namespace
+
+/**
+ * @brief Check that CompactTriggerRecordHeaders have appropriate Copy/Move semantics
+ */
+BOOST_AUTO_TEST_CASE(CopyAndMoveSemantics)
+{
+  BOOST_REQUIRE(std::is_copy_constructible_v<CompactTriggerRecordHeader>);
+  BOOST_REQUIRE(std::is_copy_assignable_v<CompactTriggerRecordHeader>);
+  BOOST_REQUIRE(std::is_nothrow_move_constructible_v<CompactTriggerRecordHeader>);
+  BOOST_REQUIRE(std::is_nothrow_move_assignable_v<CompactTriggerRecordHeader>);
+}
+
+/**
+ * @brief Check that components are encoded and expanded correctly
+ */
+BOOST_AUTO_TEST_CASE(EncodeAndExpand)
+{
+  auto header = make_header(1000);
+  CompactTriggerRecordHeader compact(header);
+
+  BOOST_REQUIRE(CompactTriggerRecordHeader::is_compact(compact.get_storage_location()));
+  BOOST_REQUIRE(!CompactTriggerRecordHeader::is_compact(header.get_storage_location()));
+  BOOST_REQUIRE_EQUAL(compact.get_num_requested_components(), 1000);
+  BOOST_REQUIRE_EQUAL(compact.get_shared_window().window_begin, 1000);
+  BOOST_REQUIRE_EQUAL(compact.get_shared_window().window_end, 2000);
+  BOOST_REQUIRE_EQUAL(compact.get_shared_window().num_window_exceptions, 100);
+  BOOST_REQUIRE(compact.get_total_size_bytes() * 3 < header.get_total_size_bytes());
+
+  BOOST_REQUIRE_EQUAL(compact.get_run_number(), 9);
+  BOOST_REQUIRE_EQUAL(compact.get_trigger_number(), 10);
+  BOOST_REQUIRE_EQUAL(compact.get_trigger_timestamp(), 11);
+  BOOST_REQUIRE_EQUAL(compact.get_trigger_type(), 12);
+  BOOST_REQUIRE_EQUAL(compact.get_sequence_number(), 13);
+  BOOST_REQUIRE_EQUAL(compact.get_max_sequence_number(), 14);
+  BOOST_REQUIRE_EQUAL(compact.get_error_bits().to_ulong(), 2);
+
+  for (size_t i = 0; i < header.get_num_requested_components(); ++i) {
+    auto component = compact.at(i);
+    BOOST_REQUIRE(component.component == header[i].component);
+    BOOST_REQUIRE_EQUAL(component.window_begin, header[i].window_begin);
+    BOOST_REQUIRE_EQUAL(component.window_end, header[i].window_end);
+  }
+  BOOST_REQUIRE_THROW(compact.at(1000), dunedaq::dataformats::ComponentRequestIndexError);
+
+  auto expanded = compact.to_trigger_record_header();
+  BOOST_REQUIRE_EQUAL(expanded.get_total_size_bytes(), header.get_total_size_bytes());
+  BOOST_REQUIRE_EQUAL(memcmp(expanded.get_storage_location(), header.get_storage_location(), // NOLINT
+                             header.get_total_size_bytes()),
+                      0);
+}
+
+/**
+ * @brief Check which version and unused fields survive the encoding: the TriggerRecordHeaderData ones do, the
+ * per-component ones are expanded with their defaults
+ */
+BOOST_AUTO_TEST_CASE(VersionAndUnusedFields)
+{
+  TriggerRecordHeaderData header_data;
+  header_data.version = 7;
+  header_data.unused = 0x1234;
+  header_data.run_number = 5;
+  TriggerRecordHeaderBuilder builder;
+  builder.set_header(header_data);
+  auto& component = builder.emplace_back(GeoID(GeoID::SystemType::kPDS, 2, 3), 100, 200);
+  component.version = 9;
+  component.unused = 0xABCD;
+  component.component.version = 4;
+  component.component.unused = 0x5678;
+  auto header = builder.build();
+  BOOST_REQUIRE_EQUAL(header.get_header().version, 7);
+
+  auto expanded = CompactTriggerRecordHeader(header).to_trigger_record_header();
+  BOOST_REQUIRE_EQUAL(expanded.get_header().trigger_record_header_marker,
+                      TriggerRecordHeaderData::s_trigger_record_header_magic);
+  BOOST_REQUIRE_EQUAL(expanded.get_header().version, 7);
+  BOOST_REQUIRE_EQUAL(expanded.get_header().unused, 0x1234);
+  BOOST_REQUIRE_EQUAL(expanded.get_run_number(), 5);
+  BOOST_REQUIRE_EQUAL(expanded.get_num_requested_components(), 1);
+
+  BOOST_REQUIRE(expanded[0].component == header[0].component);
+  BOOST_REQUIRE_EQUAL(expanded[0].window_begin, 100);
+  BOOST_REQUIRE_EQUAL(expanded[0].version, ComponentRequest::s_component_request_version);
+  BOOST_REQUIRE_EQUAL(expanded[0].unused, 0xFFFFFFFF);
+  BOOST_REQUIRE_EQUAL(expanded[0].component.version, GeoID::s_geo_id_version);
+  BOOST_REQUIRE_EQUAL(expanded[0].component.unused, 0xFFFFFFFF);
+}
+
+/**
+ * @brief Check the buffer constructors and copies
+ */
+BOOST_AUTO_TEST_CASE(ExistingBuffer)
+{
+  CompactTriggerRecordHeader compact(make_header(25));
+
+  CompactTriggerRecordHeader view(const_cast<void*>(compact.get_storage_location()), false);
+  BOOST_REQUIRE_EQUAL(view.get_storage_location(), compact.get_storage_location());
+  view.set_run_number(20);
+  BOOST_REQUIRE_EQUAL(compact.get_run_number(), 20);
+
+  CompactTriggerRecordHeader copy(compact);
+  BOOST_REQUIRE(copy.get_storage_location() != compact.get_storage_location());
+  BOOST_REQUIRE_EQUAL(copy.get_total_size_bytes(), compact.get_total_size_bytes());
+  BOOST_REQUIRE_EQUAL(copy.at(13).window_begin, 13);
+  BOOST_REQUIRE_EQUAL(copy.at(14).window_begin, 1000);
+
+  CompactTriggerRecordHeader assigned(make_header(1));
+  assigned = copy;
+  BOOST_REQUIRE_EQUAL(assigned.get_num_requested_components(), 25);
+  BOOST_REQUIRE_EQUAL(assigned.at(23).window_end, 24);
+}
+
+/**
+ * @brief Check headers without components, or where no window is shared
+ */
+BOOST_AUTO_TEST_CASE(EdgeCases)
+{
+  CompactTriggerRecordHeader empty(TriggerRecordHeader{ std::vector<ComponentRequest>() });
+  BOOST_REQUIRE_EQUAL(empty.get_num_requested_components(), 0);
+  BOOST_REQUIRE_EQUAL(empty.to_trigger_record_header().get_num_requested_components(), 0);
+
+  std::vector<ComponentRequest> components;
+  for (uint32_t i = 0; i < 5; ++i) { // NOLINT(build/unsigned)
+    components.emplace_back(GeoID(GeoID::SystemType::kPDS, 65535, 4294967295 - i), i, 2 * i);
+  }
+  CompactTriggerRecordHeader distinct(TriggerRecordHeader{ components });
+  BOOST_REQUIRE_EQUAL(distinct.get_shared_window().num_window_exceptions, 4);
+  for (size_t i = 0; i < components.size(); ++i) {
+    BOOST_REQUIRE(distinct.at(i).component == components[i].component);
+    BOOST_REQUIRE_EQUAL(distinct.at(i).window_end, components[i].window_end);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
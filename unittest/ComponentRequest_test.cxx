@@ -15,7 +15,9 @@
 
 #include "boost/test/unit_test.hpp"
 
+#include <sstream>
 #include <string>
+#include <system_error>
 #include <vector>
 
 using namespace dunedaq::dataformats;
@@ -71,4 +73,29 @@ BOOST_AUTO_TEST_CASE(StreamOperator)
   BOOST_REQUIRE_EQUAL(component_from_stream.window_end, component.window_end);
 }
 
+/**
+ * @brief Test that to_chars and from_chars match the stream operators
+ */
+BOOST_AUTO_TEST_CASE(CharConversion)
+{
+  ComponentRequest test(GeoID(GeoID::SystemType::kTPC, 1, 2), 3, 4);
+  std::ostringstream ostr;
+  ostr << test;
+
+  char buffer[128];
+  auto [end, ec] = to_chars(buffer, buffer + sizeof(buffer), test);
+  BOOST_REQUIRE(ec == std::errc());
+  BOOST_REQUIRE_EQUAL(std::string(buffer, end), ostr.str());
+
+  ComponentRequest parsed;
+  auto result = from_chars(buffer, end, parsed);
+  BOOST_REQUIRE(result.ec == std::errc());
+  BOOST_REQUIRE(result.ptr == end);
+  BOOST_REQUIRE_EQUAL(parsed.component, test.component);
+  BOOST_REQUIRE_EQUAL(parsed.window_begin, test.window_begin);
+  BOOST_REQUIRE_EQUAL(parsed.window_end, test.window_end);
+
+  BOOST_REQUIRE(to_chars(buffer, buffer + 40, test).ec == std::errc::value_too_large);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
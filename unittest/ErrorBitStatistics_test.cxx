@@ -0,0 +1,157 @@
+/**
+ * @file ErrorBitStatistics_test.cxx ErrorBitStatistics class Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/ErrorBitStatistics.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE ErrorBitStatistics_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+std::unique_ptr<Fragment>
+make_fragment(FragmentType type, const GeoID& id, uint32_t error_bits) // NOLINT(build/unsigned)
+{
+  char payload[4] = { 1, 2, 3, 4 };
+  auto frag = std::make_unique<Fragment>(payload, sizeof(payload));
+  frag->set_type(type);
+  frag->set_element_id(id);
+  frag->set_error_bits(error_bits);
+  return frag;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ErrorBitStatistics_test)
+
+/**
+ * @brief Test counting single error words
+ */
+BOOST_AUTO_TEST_CASE(Counts)
+{
+  ErrorBitCounts counts;
+  counts.add(0);
+  counts.add(0x80000003);
+  counts.add(0x2);
+  counts.add(0);
+  BOOST_REQUIRE_EQUAL(counts.entries, 4);
+  BOOST_REQUIRE_EQUAL(counts.entries_with_errors, 2);
+  BOOST_REQUIRE_EQUAL(counts.get_count(FragmentErrorBits::kDataNotFound), 1);
+  BOOST_REQUIRE_EQUAL(counts.get_count(FragmentErrorBits::kIncomplete), 2);
+  BOOST_REQUIRE_EQUAL(counts.bit_counts[31], 1);
+  BOOST_REQUIRE_CLOSE(counts.get_rate(1), 0.5, 1e-9);
+
+  ErrorBitCounts other;
+  other.add(0x2);
+  counts.merge(other);
+  BOOST_REQUIRE_EQUAL(counts.entries, 5);
+  BOOST_REQUIRE_EQUAL(counts.entries_with_errors, 3);
+  BOOST_REQUIRE_EQUAL(counts.get_count(FragmentErrorBits::kIncomplete), 3);
+  BOOST_REQUIRE_EQUAL(ErrorBitCounts().get_rate(1), 0.);
+}
+
+/**
+ * @brief Test grouping the counts of TriggerRecords and their Fragments
+ */
+BOOST_AUTO_TEST_CASE(TriggerRecords)
+{
+  const GeoID tpc0(GeoID::SystemType::kTPC, 0, 0);
+  const GeoID tpc1(GeoID::SystemType::kTPC, 0, 1);
+  const GeoID pds0(GeoID::SystemType::kPDS, 0, 0);
+  const uint32_t incomplete = 1U << static_cast<size_t>(FragmentErrorBits::kIncomplete);     // NOLINT
+  const uint32_t not_found = 1U << static_cast<size_t>(FragmentErrorBits::kDataNotFound);    // NOLINT
+
+  ErrorBitStatistics stats;
+  for (int idx = 0; idx < 4; ++idx) {
+    TriggerRecord record(std::vector<ComponentRequest>{});
+    if (idx == 3) {
+      record.get_header_ref().set_error_bit(TriggerRecordErrorBits::kIncomplete, true);
+    }
+    record.add_fragment(make_fragment(FragmentType::kTPCData, tpc0, idx == 3 ? incomplete : 0));
+    record.add_fragment(make_fragment(FragmentType::kTPCData, tpc1, 0));
+    record.add_fragment(make_fragment(FragmentType::kPDSData, pds0, idx % 2 ? not_found : 0));
+    stats.add(record);
+  }
+
+  BOOST_REQUIRE_EQUAL(stats.get_record_counts().entries, 4);
+  BOOST_REQUIRE_EQUAL(stats.get_record_counts().get_count(TriggerRecordErrorBits::kIncomplete), 1);
+  BOOST_REQUIRE_EQUAL(stats.get_fragment_counts().entries, 12);
+  BOOST_REQUIRE_EQUAL(stats.get_fragment_counts().entries_with_errors, 3);
+
+  auto tpc_counts = stats.get_counts(FragmentType::kTPCData);
+  BOOST_REQUIRE_EQUAL(tpc_counts.entries, 8);
+  BOOST_REQUIRE_EQUAL(tpc_counts.get_count(FragmentErrorBits::kIncomplete), 1);
+  BOOST_REQUIRE_EQUAL(tpc_counts.get_count(FragmentErrorBits::kDataNotFound), 0);
+  BOOST_REQUIRE_EQUAL(stats.get_counts(FragmentType::kPDSData).get_count(FragmentErrorBits::kDataNotFound), 2);
+  BOOST_REQUIRE_EQUAL(stats.get_counts(FragmentType::kTriggerPrimitives).entries, 0);
+
+  BOOST_REQUIRE_EQUAL(stats.get_counts(tpc0).get_count(FragmentErrorBits::kIncomplete), 1);
+  BOOST_REQUIRE_EQUAL(stats.get_counts(tpc1).entries_with_errors, 0);
+  BOOST_REQUIRE_EQUAL(stats.get_counts(pds0).entries, 4);
+  BOOST_REQUIRE_EQUAL(stats.get_counts(GeoID(GeoID::SystemType::kPDS, 1, 0)).entries, 0);
+  BOOST_REQUIRE_EQUAL(stats.get_counts_by_type().size(), 2);
+  BOOST_REQUIRE_EQUAL(stats.get_counts_by_element().size(), 3);
+
+  stats.clear();
+  BOOST_REQUIRE_EQUAL(stats.get_fragment_counts().entries, 0);
+  BOOST_REQUIRE(stats.get_counts_by_element().empty());
+}
+
+/**
+ * @brief Test that counting FragmentHeaderColumns and merging per-producer statistics match direct counting
+ */
+BOOST_AUTO_TEST_CASE(ColumnsAndMerge)
+{
+  std::vector<std::unique_ptr<Fragment>> fragments;
+  for (uint32_t idx = 0; idx < 100; ++idx) { // NOLINT(build/unsigned)
+    fragments.push_back(make_fragment(idx % 3 ? FragmentType::kTPCData : FragmentType::kPDSData,
+                                      GeoID(GeoID::SystemType::kTPC, idx % 5, idx % 7),
+                                      idx % 4 ? 0 : (idx * 2654435761U))); // NOLINT(build/unsigned)
+  }
+  // Then runs of one type and GeoID, some of them new, as from a readout link
+  for (uint32_t idx = 0; idx < 100; ++idx) { // NOLINT(build/unsigned)
+    fragments.push_back(make_fragment(idx < 60 ? FragmentType::kTPCData : FragmentType::kNDLArTPC,
+                                      GeoID(GeoID::SystemType::kTPC, idx / 20, 3),
+                                      idx % 6 ? 0 : (idx * 40503U))); // NOLINT(build/unsigned)
+  }
+
+  ErrorBitStatistics direct;
+  ErrorBitStatistics first_half, second_half;
+  for (size_t idx = 0; idx < fragments.size(); ++idx) {
+    direct.add(*fragments[idx]);
+    (idx < 70 ? first_half : second_half).add(*fragments[idx]);
+  }
+  FragmentHeaderColumns columns;
+  columns.append(fragments);
+  ErrorBitStatistics from_columns;
+  from_columns.add(columns);
+  first_half.merge(second_half);
+
+  for (auto* stats : { &from_columns, &first_half }) {
+    BOOST_REQUIRE(stats->get_fragment_counts().bit_counts == direct.get_fragment_counts().bit_counts);
+    BOOST_REQUIRE_EQUAL(stats->get_fragment_counts().entries, direct.get_fragment_counts().entries);
+    for (auto type : { FragmentType::kTPCData, FragmentType::kPDSData, FragmentType::kNDLArTPC }) {
+      BOOST_REQUIRE(stats->get_counts(type).bit_counts == direct.get_counts(type).bit_counts);
+    }
+    BOOST_REQUIRE_EQUAL(stats->get_counts_by_element().size(), direct.get_counts_by_element().size());
+    direct.get_counts_by_element().for_each([&](const GeoID& id, const ErrorBitCounts& counts) {
+      BOOST_REQUIRE(stats->get_counts(id).bit_counts == counts.bit_counts);
+      BOOST_REQUIRE_EQUAL(stats->get_counts(id).entries_with_errors, counts.entries_with_errors);
+    });
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
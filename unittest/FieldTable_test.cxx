@@ -0,0 +1,145 @@
+/**
+ * @file FieldTable_test.cxx FieldTable and packed codec Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/FieldTable.hpp"
+#include "dataformats/PackedCodec.hpp"
+
+#include "dataformats/ComponentRequest.hpp"
+#include "dataformats/FragmentHeader.hpp"
+#include "dataformats/GeoID.hpp"
+#include "dataformats/TriggerRecordHeaderData.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE FieldTable_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Write a struct as "name: value, ..." using only its FieldTable, as the text codecs do
+ * @param value Struct to write
+ * @return Text built from the field descriptors
+ */
+template<typename T>
+std::string
+format_fields(const T& value)
+{
+  std::ostringstream ostr;
+  bool first = true;
+  for_each_field<T>([&](const auto& field) {
+    ostr << (first ? "" : ", ");
+    first = false;
+    if (field.format != FieldFormat::kInline) {
+      ostr << field.name << ": ";
+    }
+    if (field.format == FieldFormat::kHex) {
+      ostr << std::hex << field.get(value) << std::dec;
+    } else {
+      ostr << field.get(value);
+    }
+  });
+  return ostr.str();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FieldTable_test)
+
+/**
+ * @brief Test that the field tables describe the struct layouts
+ */
+BOOST_AUTO_TEST_CASE(Descriptors)
+{
+  static_assert(num_fields_v<GeoID> == 3);
+  static_assert(num_fields_v<FragmentHeader> == 12);
+  static_assert(has_field_table_v<ComponentRequest>);
+  static_assert(!has_field_table_v<timestamp_t>);
+
+  constexpr auto element_field = std::get<8>(FieldTable<FragmentHeader>::fields);
+  static_assert(element_field.name == "element_id");
+  static_assert(std::is_same_v<decltype(element_field)::value_type, GeoID>);
+  static_assert(element_field.offset == offsetof(FragmentHeader, element_id));
+  static_assert(std::get<1>(FieldTable<ComponentRequest>::fields).offset == offsetof(ComponentRequest, window_begin));
+  static_assert(std::get<2>(FieldTable<GeoID>::fields).offset == offsetof(GeoID, element_id));
+  static_assert(are_field_offsets_consistent<FragmentHeader>());
+  static_assert(are_field_offsets_consistent<TriggerRecordHeaderData>());
+}
+
+/**
+ * @brief Test that the field tables list the fields in the order and format of the stream operators
+ */
+BOOST_AUTO_TEST_CASE(MatchesStreamFormat)
+{
+  FragmentHeader fragment_header;
+  fragment_header.trigger_number = 1;
+  fragment_header.element_id = GeoID(GeoID::SystemType::kTPC, 2, 3);
+  std::ostringstream fragment_ostr;
+  fragment_ostr << fragment_header;
+  BOOST_REQUIRE_EQUAL(format_fields(fragment_header), fragment_ostr.str());
+
+  TriggerRecordHeaderData trigger_record_header;
+  trigger_record_header.run_number = 4;
+  std::ostringstream trigger_record_ostr;
+  trigger_record_ostr << trigger_record_header;
+  BOOST_REQUIRE_EQUAL(format_fields(trigger_record_header), trigger_record_ostr.str());
+
+  ComponentRequest component_request(GeoID(GeoID::SystemType::kPDS, 5, 6), 7, 8);
+  std::ostringstream component_ostr;
+  component_ostr << component_request;
+  BOOST_REQUIRE_EQUAL(format_fields(component_request), component_ostr.str());
+}
+
+/**
+ * @brief Test the packed binary codec
+ */
+BOOST_AUTO_TEST_CASE(PackedCodec)
+{
+  static_assert(packed_size_v<GeoID> == 8);
+  static_assert(packed_size_v<ComponentRequest> == 24);
+  static_assert(packed_size_v<FragmentHeader> < sizeof(FragmentHeader));
+
+  std::vector<ComponentRequest> components;
+  for (uint32_t idx = 0; idx < 5; ++idx) { // NOLINT(build/unsigned)
+    components.emplace_back(GeoID(GeoID::SystemType::kPDS, 1, idx), 100 * idx, 100 * idx + 50);
+  }
+  std::vector<char> buffer(components.size() * packed_size_v<ComponentRequest>);
+  auto end = encode_packed(components.data(), components.size(), buffer.data());
+  BOOST_REQUIRE(end == buffer.data() + buffer.size());
+
+  std::vector<ComponentRequest> decoded(components.size());
+  auto in_end = decode_packed(buffer.data(), decoded.data(), decoded.size());
+  BOOST_REQUIRE(in_end == buffer.data() + buffer.size());
+  for (size_t idx = 0; idx < components.size(); ++idx) {
+    BOOST_REQUIRE_EQUAL(decoded[idx].component, components[idx].component);
+    BOOST_REQUIRE_EQUAL(decoded[idx].window_begin, components[idx].window_begin);
+    BOOST_REQUIRE_EQUAL(decoded[idx].window_end, components[idx].window_end);
+  }
+
+  FragmentHeader header;
+  header.run_number = 7;
+  header.element_id = GeoID(GeoID::SystemType::kNDLArTPC, 8, 9);
+  std::vector<char> header_buffer(packed_size_v<FragmentHeader>);
+  encode_packed(header, header_buffer.data());
+  FragmentHeader decoded_header;
+  decode_packed(header_buffer.data(), decoded_header);
+  BOOST_REQUIRE_EQUAL(decoded_header.run_number, header.run_number);
+  BOOST_REQUIRE_EQUAL(decoded_header.element_id, header.element_id);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+/**
+ * @file FragmentHeaderColumns_test.cxx FragmentHeaderColumns struct Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/FragmentHeaderColumns.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE FragmentHeaderColumns_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+std::unique_ptr<Fragment>
+make_fragment(uint32_t idx) // NOLINT(build/unsigned)
+{
+  std::vector<char> payload(idx % 7 + 1, 'a');
+  auto frag = std::make_unique<Fragment>(payload.data(), payload.size());
+  frag->set_trigger_number(100 + idx / 4);
+  frag->set_run_number(idx < 8 ? 1 : 2);
+  frag->set_trigger_timestamp(1000 * idx);
+  frag->set_window_begin(1000 * idx - 10);
+  frag->set_window_end(1000 * idx + 10);
+  frag->set_element_id(GeoID(GeoID::SystemType::kTPC, idx % 4, idx));
+  frag->set_type(FragmentType::kTPCData);
+  frag->set_sequence_number(idx % 2);
+  if (idx % 3 == 0) {
+    frag->set_error_bit(FragmentErrorBits::kIncomplete, true);
+  }
+  return frag;
+}
+
+void
+check_row(const FragmentHeaderColumns& columns, size_t row, const Fragment& frag)
+{
+  auto header = frag.get_header();
+  size_t num_columns = 0;
+  columns.for_each_column([&](const auto& field, const auto& column) {
+    using traits_t = ColumnTraits<typename std::decay_t<decltype(field)>::value_type>;
+    BOOST_REQUIRE_EQUAL(column.size(), columns.size());
+    BOOST_REQUIRE(column[row] == traits_t::to_column(field.get(header)));
+    ++num_columns;
+  });
+  BOOST_REQUIRE_EQUAL(num_columns, num_fields_v<FragmentHeader>);
+
+  BOOST_REQUIRE_EQUAL(columns.get<&FragmentHeader::trigger_number>()[row], header.trigger_number);
+  BOOST_REQUIRE_EQUAL(columns.get<&FragmentHeader::window_end>()[row], header.window_end);
+  BOOST_REQUIRE(GeoID::from_key(columns.get<&FragmentHeader::element_id>()[row]) == header.element_id);
+  BOOST_REQUIRE_EQUAL(columns.get<&FragmentHeader::size>()[row], header.size);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FragmentHeaderColumns_test)
+
+/**
+ * @brief Test extracting the headers of a list of Fragments
+ */
+BOOST_AUTO_TEST_CASE(FromFragments)
+{
+  std::vector<std::unique_ptr<Fragment>> fragments;
+  for (uint32_t idx = 0; idx < 16; ++idx) { // NOLINT(build/unsigned)
+    fragments.push_back(make_fragment(idx));
+  }
+
+  FragmentHeaderColumns columns;
+  BOOST_REQUIRE(columns.empty());
+  columns.append(fragments);
+  BOOST_REQUIRE_EQUAL(columns.size(), fragments.size());
+  for (size_t row = 0; row < fragments.size(); ++row) {
+    check_row(columns, row, *fragments[row]);
+  }
+
+  // Single headers go after the batch
+  columns.append(fragments[3]->get_header());
+  BOOST_REQUIRE_EQUAL(columns.size(), fragments.size() + 1);
+  check_row(columns, fragments.size(), *fragments[3]);
+
+  columns.clear();
+  BOOST_REQUIRE(columns.empty());
+  BOOST_REQUIRE_EQUAL(columns.get<&FragmentHeader::error_bits>().size(), 0);
+}
+
+/**
+ * @brief Test a selection over the columns: Fragments of run 1 in region 2 marked kIncomplete
+ */
+BOOST_AUTO_TEST_CASE(Query)
+{
+  std::vector<std::unique_ptr<Fragment>> fragments;
+  for (uint32_t idx = 0; idx < 16; ++idx) { // NOLINT(build/unsigned)
+    fragments.push_back(make_fragment(idx));
+  }
+  FragmentHeaderColumns columns;
+  columns.append(fragments);
+
+  const uint32_t incomplete = 1U << static_cast<size_t>(FragmentErrorBits::kIncomplete); // NOLINT(build/unsigned)
+  auto& error_bits = columns.get<&FragmentHeader::error_bits>();
+  auto& run_number = columns.get<&FragmentHeader::run_number>();
+  auto& element_key = columns.get<&FragmentHeader::element_id>();
+  std::vector<size_t> selected;
+  for (size_t row = 0; row < columns.size(); ++row) {
+    if ((error_bits[row] & incomplete) && run_number[row] == 1 && GeoID::from_key(element_key[row]).region_id == 2) {
+      selected.push_back(row);
+    }
+  }
+  BOOST_REQUIRE(selected == std::vector<size_t>{ 6 });
+}
+
+/**
+ * @brief Test extracting the headers of Fragments serialized back to back
+ */
+BOOST_AUTO_TEST_CASE(Serialized)
+{
+  std::vector<std::unique_ptr<Fragment>> fragments;
+  std::vector<char> buffer(1); // Start at an odd offset, so that the headers are misaligned
+  for (uint32_t idx = 0; idx < 5; ++idx) { // NOLINT(build/unsigned)
+    fragments.push_back(make_fragment(idx));
+    auto data = static_cast<const char*>(fragments.back()->get_storage_location());
+    buffer.insert(buffer.end(), data, data + fragments.back()->get_size());
+  }
+
+  FragmentHeaderColumns columns;
+  BOOST_REQUIRE_EQUAL(columns.append_serialized(buffer.data() + 1, buffer.size() - 1), fragments.size());
+  BOOST_REQUIRE_EQUAL(columns.size(), fragments.size());
+  for (size_t row = 0; row < fragments.size(); ++row) {
+    check_row(columns, row, *fragments[row]);
+  }
+
+  // A truncated region keeps the rows of the complete Fragments before the error
+  columns.clear();
+  BOOST_REQUIRE_EXCEPTION(columns.append_serialized(buffer.data() + 1, buffer.size() - 2),
+                          FragmentBufferError,
+                          [&](FragmentBufferError) { return true; });
+  BOOST_REQUIRE_EQUAL(columns.size(), fragments.size() - 1);
+
+  // So does a region that does not start with a FragmentHeader
+  columns.clear();
+  buffer[1] ^= 0x1;
+  BOOST_REQUIRE_EXCEPTION(columns.append_serialized(buffer.data() + 1, buffer.size() - 1),
+                          FragmentBufferError,
+                          [&](FragmentBufferError) { return true; });
+  BOOST_REQUIRE(columns.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
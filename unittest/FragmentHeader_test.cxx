@@ -15,7 +15,9 @@
 
 #include "boost/test/unit_test.hpp"
 
+#include <sstream>
 #include <string>
+#include <system_error>
 #include <vector>
 
 using namespace dunedaq::dataformats;
@@ -75,4 +77,39 @@ BOOST_AUTO_TEST_CASE(StreamOperator)
   BOOST_REQUIRE_EQUAL(header_from_stream.sequence_number, header.sequence_number);
 }
 
+/**
+ * @brief Test that to_chars and from_chars match the stream operators
+ */
+BOOST_AUTO_TEST_CASE(CharConversion)
+{
+  FragmentHeader header;
+  header.size = sizeof(FragmentHeader) + 4;
+  header.trigger_number = 1;
+  header.trigger_timestamp = 2;
+  header.run_number = 3;
+  header.sequence_number = 4;
+  header.element_id = GeoID(GeoID::SystemType::kPDS, 5, 6);
+  header.error_bits = 7;
+
+  std::ostringstream ostr;
+  ostr << header;
+
+  char buffer[512];
+  auto [end, ec] = to_chars(buffer, buffer + sizeof(buffer), header);
+  BOOST_REQUIRE(ec == std::errc());
+  BOOST_REQUIRE_EQUAL(std::string(buffer, end), ostr.str());
+
+  FragmentHeader parsed;
+  parsed.element_id = GeoID();
+  auto result = from_chars(buffer, end, parsed);
+  BOOST_REQUIRE(result.ec == std::errc());
+  BOOST_REQUIRE(result.ptr == end);
+  std::ostringstream parsed_ostr;
+  parsed_ostr << parsed;
+  BOOST_REQUIRE_EQUAL(parsed_ostr.str(), ostr.str());
+
+  BOOST_REQUIRE(to_chars(buffer, buffer + 100, header).ec == std::errc::value_too_large);
+  BOOST_REQUIRE(from_chars(buffer, buffer + 100, parsed).ec != std::errc());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,101 @@
+/**
+ * @file FragmentTypeTraits_test.cxx FragmentTypeTraits Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/FragmentTypeTraits.hpp"
+#include "dataformats/wib2/WIB2Frame.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE FragmentTypeTraits_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+BOOST_AUTO_TEST_SUITE(FragmentTypeTraits_test)
+
+/**
+ * @brief Test the compile-time properties of the FragmentTypes
+ */
+BOOST_AUTO_TEST_CASE(StaticProperties)
+{
+  using tpc_traits = FragmentTypeTraits<FragmentType::kTPCData>;
+  static_assert(tpc_traits::name == "TPC");
+  static_assert(tpc_traits::system_type == GeoID::SystemType::kTPC);
+  static_assert(!has_frames_v<FragmentType::kTPCData>);
+
+  using pds_traits = FragmentTypeTraits<FragmentType::kPDSData>;
+  static_assert(pds_traits::system_type == GeoID::SystemType::kPDS);
+  static_assert(std::is_same_v<pds_traits::frame_type, DAPHNEFrame>);
+  static_assert(pds_traits::frame_size == sizeof(DAPHNEFrame));
+  static_assert(has_frames_v<FragmentType::kPDSData>);
+  static_assert(std::is_same_v<decltype(pds_traits::get_frames(std::declval<const Fragment&>())), const DAPHNEFrame*>);
+
+  // The WIB version of a TPC payload is known from elsewhere
+  using wib2_traits = FrameFragmentTypeTraits<FragmentType::kTPCData, GeoID::SystemType::kTPC, WIB2Frame>;
+  static_assert(wib2_traits::frame_size == sizeof(WIB2Frame));
+
+  using tp_traits = FragmentTypeTraits<FragmentType::kTriggerPrimitives>;
+  static_assert(tp_traits::name == "TriggerPrimitives");
+  static_assert(tp_traits::system_type == GeoID::SystemType::kDataSelection);
+  static_assert(!has_frames_v<FragmentType::kTriggerPrimitives>);
+  static_assert(!has_frames_v<FragmentType::kNDLArTPC>);
+
+  static_assert(FragmentTypeTraits<FragmentType::kUnknown>::name.empty());
+
+  for (auto type : s_named_fragment_types) {
+    BOOST_REQUIRE_EQUAL(get_fragment_type_names().at(type), std::string(fragment_type_to_string_view(type)));
+  }
+  BOOST_REQUIRE_EQUAL(get_fragment_type_names().size(), std::size(s_named_fragment_types));
+}
+
+/**
+ * @brief Test dispatching on a run-time FragmentType
+ */
+BOOST_AUTO_TEST_CASE(Visit)
+{
+  for (auto type : s_named_fragment_types) {
+    auto visited = visit_fragment_type(type, [](auto traits) { return decltype(traits)::fragment_type; });
+    BOOST_REQUIRE(visited == type);
+  }
+  auto name = visit_fragment_type(static_cast<FragmentType>(1234), [](auto traits) { return decltype(traits)::name; });
+  BOOST_REQUIRE(name.empty());
+
+  std::vector<DAPHNEFrame> frames(3);
+  for (size_t idx = 0; idx < frames.size(); ++idx) {
+    frames[idx].header.timestamp_wf_1 = 100 + 25 * idx;
+    frames[idx].header.timestamp_wf_2 = 0;
+  }
+  Fragment fragment(frames.data(), frames.size() * sizeof(DAPHNEFrame));
+  fragment.set_type(FragmentType::kPDSData);
+
+  std::vector<timestamp_t> timestamps;
+  visit_fragment_type(fragment, [&](auto traits) {
+    using traits_t = decltype(traits);
+    if constexpr (has_frames_v<traits_t::fragment_type>) {
+      auto frame_ptr = traits_t::get_frames(fragment);
+      for (size_t idx = 0; idx < traits_t::get_num_frames(fragment); ++idx) {
+        timestamps.push_back(traits_t::get_timestamp(frame_ptr[idx]));
+      }
+    }
+  });
+  BOOST_REQUIRE(timestamps == (std::vector<timestamp_t>{ 100, 125, 150 }));
+
+  // TPC payloads are not split into frames, as their WIB version is not known
+  fragment.set_type(FragmentType::kTPCData);
+  size_t frame_size = visit_fragment_type(fragment, [](auto traits) { return decltype(traits)::frame_size; });
+  BOOST_REQUIRE_EQUAL(frame_size, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,8 +25,10 @@
 
 #include "boost/test/unit_test.hpp"
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -43,6 +45,40 @@ BOOST_AUTO_TEST_CASE(CopyAndMoveSemantics)
   BOOST_REQUIRE(!std::is_copy_assignable_v<Fragment>);
   BOOST_REQUIRE(std::is_move_constructible_v<Fragment>);
   BOOST_REQUIRE(std::is_move_assignable_v<Fragment>);
+  BOOST_REQUIRE(std::is_nothrow_move_constructible_v<Fragment>);
+  BOOST_REQUIRE(std::is_nothrow_move_assignable_v<Fragment>);
+}
+
+/**
+ * @brief Check that moving a Fragment transfers ownership of its data array
+ */
+BOOST_AUTO_TEST_CASE(MoveOwnership)
+{
+  // Large enough that the Fragments keep their data on the heap
+  std::vector<uint8_t> buf(Fragment::s_inline_storage_size, 0xAA); // NOLINT(build/unsigned)
+
+  Fragment frag(&buf[0], buf.size());
+  frag.set_trigger_number(1);
+  auto storage = frag.get_storage_location();
+
+  Fragment moved_frag(std::move(frag));
+  BOOST_REQUIRE_EQUAL(moved_frag.get_storage_location(), storage);
+  BOOST_REQUIRE_EQUAL(moved_frag.get_trigger_number(), 1);
+  BOOST_REQUIRE(frag.get_storage_location() == nullptr); // NOLINT(bugprone-use-after-move)
+
+  std::vector<Fragment> frags;
+  frags.emplace_back(&buf[0], buf.size());
+  frags.back().set_trigger_number(2);
+  frags.push_back(std::move(moved_frag));
+  frags.emplace_back(&buf[0], buf.size());
+  BOOST_REQUIRE_EQUAL(frags[0].get_trigger_number(), 2);
+  BOOST_REQUIRE_EQUAL(frags[1].get_storage_location(), storage);
+  BOOST_REQUIRE_EQUAL(*static_cast<uint8_t*>(frags[2].get_data()), 0xAA); // NOLINT(build/unsigned)
+
+  frags[0] = std::move(frags[1]);
+  BOOST_REQUIRE_EQUAL(frags[0].get_storage_location(), storage);
+  BOOST_REQUIRE_EQUAL(frags[0].get_trigger_number(), 1);
+  BOOST_REQUIRE(frags[1].get_storage_location() == nullptr);
 }
 
 /**
@@ -59,6 +95,102 @@ BOOST_AUTO_TEST_CASE(DataConstructors)
   BOOST_REQUIRE_EQUAL(collect_frag.get_size(), sizeof(FragmentHeader) + 30);
 }
 
+/**
+ * @brief Check that small Fragments use the inline storage and large ones the heap
+ */
+BOOST_AUTO_TEST_CASE(InlineStorage)
+{
+  auto is_inline = [](const Fragment& frag) {
+    auto location = static_cast<const uint8_t*>(frag.get_storage_location()); // NOLINT(build/unsigned)
+    auto object = reinterpret_cast<const uint8_t*>(&frag);                    // NOLINT
+    return location >= object && location < object + sizeof(Fragment);
+  };
+
+  std::vector<uint8_t> buf(Fragment::s_inline_storage_size); // NOLINT(build/unsigned)
+  for (size_t i = 0; i < buf.size(); ++i) {
+    buf[i] = i;
+  }
+
+  const size_t small_size = Fragment::s_inline_storage_size - sizeof(FragmentHeader);
+  Fragment small_frag(&buf[0], small_size);
+  BOOST_REQUIRE(is_inline(small_frag));
+  BOOST_REQUIRE_EQUAL(small_frag.get_size(), Fragment::s_inline_storage_size);
+
+  Fragment large_frag(&buf[0], small_size + 1);
+  BOOST_REQUIRE(!is_inline(large_frag));
+  BOOST_REQUIRE_EQUAL(large_frag.get_size(), Fragment::s_inline_storage_size + 1);
+
+  small_frag.set_trigger_number(5);
+  Fragment moved_frag(std::move(small_frag));
+  BOOST_REQUIRE(is_inline(moved_frag));
+  BOOST_REQUIRE(small_frag.get_storage_location() == nullptr); // NOLINT(bugprone-use-after-move)
+  BOOST_REQUIRE_EQUAL(moved_frag.get_trigger_number(), 5);
+  BOOST_REQUIRE_EQUAL(moved_frag.get_size(), Fragment::s_inline_storage_size);
+  BOOST_REQUIRE_EQUAL(memcmp(moved_frag.get_data(), &buf[0], small_size), 0);
+
+  large_frag = std::move(moved_frag);
+  BOOST_REQUIRE(is_inline(large_frag));
+  BOOST_REQUIRE_EQUAL(large_frag.get_trigger_number(), 5);
+  BOOST_REQUIRE_EQUAL(memcmp(large_frag.get_data(), &buf[0], small_size), 0);
+}
+
+/**
+ * @brief Check which pointers into a Fragment survive a move: those into a heap data array, not inline ones
+ */
+BOOST_AUTO_TEST_CASE(MovePointerStability)
+{
+  std::vector<uint8_t> buf(Fragment::s_inline_storage_size, 0x5A); // NOLINT(build/unsigned)
+
+  Fragment heap_frag(&buf[0], buf.size());
+  auto heap_storage = heap_frag.get_storage_location();
+  auto heap_data = heap_frag.get_data();
+  Fragment moved_heap_frag(std::move(heap_frag));
+  BOOST_REQUIRE_EQUAL(moved_heap_frag.get_storage_location(), heap_storage);
+  BOOST_REQUIRE_EQUAL(moved_heap_frag.get_data(), heap_data);
+
+  Fragment inline_frag(&buf[0], Fragment::s_inline_storage_size - sizeof(FragmentHeader));
+  auto inline_storage = inline_frag.get_storage_location();
+  auto inline_data = inline_frag.get_data();
+  Fragment moved_inline_frag(std::move(inline_frag));
+  BOOST_REQUIRE_NE(moved_inline_frag.get_storage_location(), inline_storage);
+  BOOST_REQUIRE_NE(moved_inline_frag.get_data(), inline_data);
+  BOOST_REQUIRE_EQUAL(static_cast<const uint8_t*>(moved_inline_frag.get_data()) - // NOLINT(build/unsigned)
+                        static_cast<const uint8_t*>(moved_inline_frag.get_storage_location()), // NOLINT(build/unsigned)
+                      sizeof(FragmentHeader));
+  BOOST_REQUIRE_EQUAL(*static_cast<const uint8_t*>(moved_inline_frag.get_data()), 0x5A); // NOLINT(build/unsigned)
+
+  moved_heap_frag = std::move(moved_inline_frag);
+  BOOST_REQUIRE_NE(moved_heap_frag.get_storage_location(), heap_storage);
+  BOOST_REQUIRE_EQUAL(moved_heap_frag.get_size(), Fragment::s_inline_storage_size);
+}
+
+/**
+ * @brief Check the factory for header-only Fragments
+ */
+BOOST_AUTO_TEST_CASE(EmptyFragment)
+{
+  FragmentHeader header;
+  header.size = 1000;
+  header.trigger_number = 1;
+  header.run_number = 2;
+  header.error_bits = 0x10;
+  header.element_id = GeoID(GeoID::SystemType::kTPC, 3, 4);
+
+  auto frag = Fragment::create_empty(header);
+  BOOST_REQUIRE_EQUAL(frag.get_size(), sizeof(FragmentHeader));
+  BOOST_REQUIRE_EQUAL(frag.get_trigger_number(), 1);
+  BOOST_REQUIRE_EQUAL(frag.get_run_number(), 2);
+  BOOST_REQUIRE_EQUAL(frag.get_element_id().element_id, 4);
+  BOOST_REQUIRE_EQUAL(frag.get_error_bits().to_ulong(), 0x11);
+  BOOST_REQUIRE(frag.get_error_bit(FragmentErrorBits::kDataNotFound));
+
+  auto incomplete_frag = Fragment::create_empty(FragmentHeader(), FragmentErrorBits::kIncomplete);
+  BOOST_REQUIRE_EQUAL(incomplete_frag.get_size(), sizeof(FragmentHeader));
+  BOOST_REQUIRE_EQUAL(incomplete_frag.get_error_bits().to_ulong(), 0x2);
+  BOOST_REQUIRE_EQUAL(static_cast<const FragmentHeader*>(incomplete_frag.get_storage_location())->fragment_header_marker,
+                      FragmentHeader::s_fragment_header_magic);
+}
+
 /**
  * @brief Test construction of invalid Fragments
  */
@@ -264,4 +396,52 @@ BOOST_AUTO_TEST_CASE(HeaderFields)
   BOOST_REQUIRE_EQUAL(theHeader->error_bits, 0);
 }
 
+/**
+ * @brief Test that atomic error bit updates from several threads are not lost
+ */
+BOOST_AUTO_TEST_CASE(AtomicErrorBits)
+{
+  char buf[8] = {};
+  Fragment obj(buf, sizeof(buf));
+  // Every thread flips its own bits many times and finally sets them; a lost update would leave a bit clear
+  constexpr size_t num_threads = 8;
+  std::vector<std::thread> threads;
+  for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    threads.emplace_back([&, thread_idx]() {
+      for (int iter = 0; iter < 10000; ++iter) {
+        for (size_t bit = thread_idx; bit < 32; bit += num_threads) {
+          obj.atomic_set_error_bit(static_cast<FragmentErrorBits>(bit), iter % 2 == 0);
+        }
+      }
+      for (size_t bit = thread_idx; bit < 32; bit += num_threads) {
+        obj.atomic_set_error_bit(static_cast<FragmentErrorBits>(bit), true);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_REQUIRE(obj.atomic_get_error_bits().all());
+
+  // Exactly one thread wins a race to set the same bit
+  obj.set_error_bits(0);
+  std::atomic<int> winners{ 0 };
+  threads.clear();
+  for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    threads.emplace_back([&]() {
+      if (!obj.atomic_test_and_set_error_bit(static_cast<FragmentErrorBits>(1))) {
+        ++winners;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_REQUIRE_EQUAL(winners.load(), 1);
+  BOOST_REQUIRE(obj.get_error_bit(static_cast<FragmentErrorBits>(1)));
+  BOOST_REQUIRE(obj.atomic_test_and_clear_error_bit(static_cast<FragmentErrorBits>(1)));
+  BOOST_REQUIRE(!obj.atomic_test_and_clear_error_bit(static_cast<FragmentErrorBits>(1)));
+  BOOST_REQUIRE_EQUAL(obj.get_error_bits().to_ulong(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,143 @@
+/**
+ * @file FrameTranspose_test.cxx Channel-major transpose Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/FrameTranspose.hpp"
+
+#include "RandomFrames.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE FrameTranspose_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+constexpr uint16_t s_padding = 0xDEAD; // NOLINT(build/unsigned)
+
+/**
+ * @brief Transpose a channel range and compare it, and the padding, with a per-value accessor
+ */
+template<typename Frame, typename Get>
+void
+check_transpose(const std::vector<Frame>& frames, size_t row_stride, int first_channel, int num_channels, Get&& get)
+{
+  std::vector<uint16_t> adcs(num_channels * row_stride, s_padding); // NOLINT(build/unsigned)
+  transpose_to_channel_major(frames.data(), frames.size(), adcs.data(), row_stride, first_channel, num_channels);
+  for (int ch = 0; ch < num_channels; ++ch) {
+    for (size_t tick = 0; tick < row_stride; ++tick) {
+      uint16_t expected = tick < frames.size() ? get(frames[tick], first_channel + ch) : s_padding; // NOLINT
+      BOOST_REQUIRE_EQUAL(adcs[ch * row_stride + tick], expected);
+    }
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(FrameTranspose_test)
+
+BOOST_AUTO_TEST_CASE(RowStride)
+{
+  BOOST_REQUIRE_EQUAL(get_channel_major_row_stride(0), 0);
+  BOOST_REQUIRE_EQUAL(get_channel_major_row_stride(1), s_channel_major_row_alignment);
+  BOOST_REQUIRE_EQUAL(get_channel_major_row_stride(s_channel_major_row_alignment), s_channel_major_row_alignment);
+  BOOST_REQUIRE_EQUAL(get_channel_major_row_stride(77), 96);
+}
+
+BOOST_AUTO_TEST_CASE(WIBFrames)
+{
+  // Enough frames for several tiles, the last one partial and not a multiple of the block size
+  auto frames = make_random_frames<WIBFrame>(77, 2468);
+  auto get = [](const WIBFrame& frame, int ch) { return frame.get_channel(ch); };
+  check_transpose(frames, get_channel_major_row_stride(frames.size()), 0, WIBFrame::s_num_ch_per_frame, get);
+  check_transpose(frames, frames.size(), 3, 250, get);
+  check_transpose(frames, 101, 13, 5, get);
+  check_transpose(frames, frames.size(), 40, 0, get);
+  check_transpose(std::vector<WIBFrame>(frames.begin(), frames.begin() + 5), 8, 0, 16, get);
+}
+
+BOOST_AUTO_TEST_CASE(WIB2Frames)
+{
+  auto frames = make_random_frames<WIB2Frame>(77, 2468);
+  auto get = [](const WIB2Frame& frame, int ch) { return frame.get_adc(ch); };
+  check_transpose(frames, get_channel_major_row_stride(frames.size()), 0, WIB2Frame::s_num_channels, get);
+  check_transpose(frames, frames.size(), 128, 128, get);
+  check_transpose(frames, 90, 250, 6, get);
+}
+
+BOOST_AUTO_TEST_CASE(WIB2Planes)
+{
+  auto frames = make_random_frames<WIB2Frame>(77, 2468);
+  std::vector<int16_t> pedestals(WIB2Frame::s_num_channels);
+  std::mt19937 gen(1357);
+  std::uniform_int_distribution<int> pedestal(0, (1 << WIB2Frame::s_bits_per_adc) - 1);
+  for (auto& ped : pedestals) {
+    ped = pedestal(gen);
+  }
+
+  for (size_t row_stride : { frames.size(), get_channel_major_row_stride(frames.size()) }) {
+    const int16_t padding = -12345;
+    std::vector<int16_t> u(2 * WIB2Frame::s_u_channels_per_femb * row_stride, padding);
+    std::vector<int16_t> v(2 * WIB2Frame::s_v_channels_per_femb * row_stride, padding);
+    std::vector<int16_t> x(2 * WIB2Frame::s_x_channels_per_femb * row_stride, padding);
+    transpose_to_planes(frames.data(), frames.size(), pedestals.data(), u.data(), v.data(), x.data(), row_stride);
+
+    for (int femb = 0; femb < WIB2Frame::s_fembs_per_frame; ++femb) {
+      const int first = femb * WIB2Frame::s_channels_per_femb;
+      const int x_offset = WIB2Frame::s_u_channels_per_femb + WIB2Frame::s_v_channels_per_femb;
+      for (size_t tick = 0; tick < row_stride; ++tick) {
+        const bool in_range = tick < frames.size();
+        for (int i = 0; i < WIB2Frame::s_u_channels_per_femb; ++i) {
+          int16_t expected = in_range ? frames[tick].get_u(femb, i) - pedestals[first + i] : padding;
+          BOOST_REQUIRE_EQUAL(u[(femb * WIB2Frame::s_u_channels_per_femb + i) * row_stride + tick], expected);
+        }
+        for (int i = 0; i < WIB2Frame::s_v_channels_per_femb; ++i) {
+          int16_t expected =
+            in_range ? frames[tick].get_v(femb, i) - pedestals[first + WIB2Frame::s_u_channels_per_femb + i] : padding;
+          BOOST_REQUIRE_EQUAL(v[(femb * WIB2Frame::s_v_channels_per_femb + i) * row_stride + tick], expected);
+        }
+        for (int i = 0; i < WIB2Frame::s_x_channels_per_femb; ++i) {
+          int16_t expected = in_range ? frames[tick].get_x(femb, i) - pedestals[first + x_offset + i] : padding;
+          BOOST_REQUIRE_EQUAL(x[(femb * WIB2Frame::s_x_channels_per_femb + i) * row_stride + tick], expected);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  auto frames = make_random_frames<WIBFrame>(10, 2468);
+  std::vector<uint16_t> adcs(WIBFrame::s_num_ch_per_frame * 10); // NOLINT(build/unsigned)
+  BOOST_REQUIRE_THROW(transpose_to_channel_major(frames.data(), 10, adcs.data(), 10, -1, 8),
+                      FrameTransposeChannelRangeError);
+  BOOST_REQUIRE_THROW(transpose_to_channel_major(frames.data(), 10, adcs.data(), 10, 250, 7),
+                      FrameTransposeChannelRangeError);
+  BOOST_REQUIRE_THROW(transpose_to_channel_major(frames.data(), 10, adcs.data(), 10, 0, -1),
+                      FrameTransposeChannelRangeError);
+  BOOST_REQUIRE_THROW(transpose_to_channel_major(frames.data(), 10, adcs.data(), 9), FrameTransposeRowStrideError);
+
+  auto wib2_frames = make_random_frames<WIB2Frame>(10, 2468);
+  BOOST_REQUIRE_THROW(transpose_to_channel_major(wib2_frames.data(), 10, adcs.data(), 10, 0, 257),
+                      FrameTransposeChannelRangeError);
+  BOOST_REQUIRE_NO_THROW(transpose_to_channel_major(wib2_frames.data(), 10, adcs.data(), 10));
+
+  std::vector<int16_t> pedestals(WIB2Frame::s_num_channels);
+  std::vector<int16_t> planes(WIB2Frame::s_num_channels * 10);
+  BOOST_REQUIRE_THROW(
+    transpose_to_planes(wib2_frames.data(), 10, pedestals.data(), planes.data(), planes.data(), planes.data(), 9),
+    FrameTransposeRowStrideError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
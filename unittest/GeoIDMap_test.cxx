@@ -0,0 +1,120 @@
+/**
+ * @file GeoIDMap_test.cxx GeoIDMap class Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/GeoIDMap.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE GeoIDMap_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <map>
+#include <string>
+
+using namespace dunedaq::dataformats;
+
+BOOST_AUTO_TEST_SUITE(GeoIDMap_test)
+
+/**
+ * @brief Test inserting and looking up GeoIDs
+ */
+BOOST_AUTO_TEST_CASE(InsertFind)
+{
+  GeoIDMap<std::string> map;
+  BOOST_REQUIRE(map.empty());
+  BOOST_REQUIRE(map.find(GeoID(GeoID::SystemType::kTPC, 1, 2)) == nullptr);
+
+  auto [value, inserted] = map.insert(GeoID(GeoID::SystemType::kTPC, 1, 2), "first");
+  BOOST_REQUIRE(inserted);
+  BOOST_REQUIRE_EQUAL(*value, "first");
+
+  std::tie(value, inserted) = map.insert(GeoID(GeoID::SystemType::kTPC, 1, 2), "second");
+  BOOST_REQUIRE(!inserted);
+  BOOST_REQUIRE_EQUAL(*value, "first");
+
+  map[GeoID(GeoID::SystemType::kPDS, 1, 2)] = "third";
+  BOOST_REQUIRE_EQUAL(map.size(), 2);
+  BOOST_REQUIRE(map.contains(GeoID(GeoID::SystemType::kPDS, 1, 2)));
+  BOOST_REQUIRE(!map.contains(GeoID(GeoID::SystemType::kPDS, 1, 3)));
+  BOOST_REQUIRE_EQUAL(*map.find(GeoID(GeoID::SystemType::kPDS, 1, 2)), "third");
+  BOOST_REQUIRE_EQUAL(map[GeoID(GeoID::SystemType::kPDS, 1, 3)], "");
+  BOOST_REQUIRE_EQUAL(map.size(), 3);
+
+  map.clear();
+  BOOST_REQUIRE(map.empty());
+  BOOST_REQUIRE(!map.contains(GeoID(GeoID::SystemType::kTPC, 1, 2)));
+}
+
+/**
+ * @brief Test that the map stays consistent with std::map through growth and erasure
+ */
+BOOST_AUTO_TEST_CASE(GrowErase)
+{
+  GeoIDMap<int> map;
+  std::map<GeoID, int> reference;
+  for (int idx = 0; idx < 1000; ++idx) {
+    GeoID id(GeoID::SystemType::kTPC, idx % 7, idx * 13);
+    map[id] = idx;
+    reference[id] = idx;
+  }
+  BOOST_REQUIRE_EQUAL(map.size(), reference.size());
+
+  for (int idx = 0; idx < 1000; idx += 3) {
+    GeoID id(GeoID::SystemType::kTPC, idx % 7, idx * 13);
+    BOOST_REQUIRE_EQUAL(map.erase(id), reference.erase(id) == 1);
+    BOOST_REQUIRE(!map.erase(id));
+  }
+  BOOST_REQUIRE_EQUAL(map.size(), reference.size());
+
+  for (auto& [id, value] : reference) {
+    auto found = map.find(id);
+    BOOST_REQUIRE(found != nullptr);
+    BOOST_REQUIRE_EQUAL(*found, value);
+  }
+
+  size_t visited = 0;
+  map.for_each([&](const GeoID& id, int& value) {
+    BOOST_REQUIRE_EQUAL(reference.at(id), value);
+    ++visited;
+  });
+  BOOST_REQUIRE_EQUAL(visited, reference.size());
+}
+
+/**
+ * @brief Test that a moved-from map is empty and still usable
+ */
+BOOST_AUTO_TEST_CASE(MovedFrom)
+{
+  const GeoID id(GeoID::SystemType::kTPC, 1, 2);
+  GeoIDMap<int> map;
+  map[id] = 7;
+
+  GeoIDMap<int> moved(std::move(map));
+  BOOST_REQUIRE_EQUAL(*moved.find(id), 7);
+  BOOST_REQUIRE(map.empty()); // NOLINT(bugprone-use-after-move)
+  BOOST_REQUIRE(map.find(id) == nullptr);
+  BOOST_REQUIRE(!map.contains(id));
+  BOOST_REQUIRE(!map.erase(id));
+  map.for_each([](const GeoID&, int) { BOOST_FAIL("moved-from map is not empty"); });
+
+  GeoIDMap<int> assigned;
+  assigned = std::move(moved);
+  BOOST_REQUIRE_EQUAL(*assigned.find(id), 7);
+  BOOST_REQUIRE(moved.empty()); // NOLINT(bugprone-use-after-move)
+  BOOST_REQUIRE(static_cast<const GeoIDMap<int>&>(moved).find(id) == nullptr);
+
+  map[id] = 8;
+  BOOST_REQUIRE_EQUAL(map.size(), 1);
+  BOOST_REQUIRE_EQUAL(*map.find(id), 8);
+  map.clear();
+  moved.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
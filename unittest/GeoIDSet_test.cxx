@@ -0,0 +1,127 @@
+/**
+ * @file GeoIDSet_test.cxx GeoIDSet class Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/GeoIDSet.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE GeoIDSet_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+BOOST_AUTO_TEST_SUITE(GeoIDSet_test)
+
+/**
+ * @brief Test inserting, looking up and erasing GeoIDs
+ */
+BOOST_AUTO_TEST_CASE(InsertContains)
+{
+  GeoIDSet set;
+  BOOST_REQUIRE(set.empty());
+  BOOST_REQUIRE(set.insert(GeoID(GeoID::SystemType::kTPC, 1, 130)));
+  BOOST_REQUIRE(!set.insert(GeoID(GeoID::SystemType::kTPC, 1, 130)));
+  BOOST_REQUIRE(set.insert(GeoID(GeoID::SystemType::kTPC, 2, 130)));
+  BOOST_REQUIRE(set.insert(GeoID(GeoID::SystemType::kPDS, 1, 0)));
+  BOOST_REQUIRE_EQUAL(set.size(), 3);
+
+  BOOST_REQUIRE(set.contains(GeoID(GeoID::SystemType::kTPC, 1, 130)));
+  BOOST_REQUIRE(!set.contains(GeoID(GeoID::SystemType::kTPC, 1, 131)));
+  BOOST_REQUIRE(!set.contains(GeoID(GeoID::SystemType::kTPC, 1, 100000)));
+  BOOST_REQUIRE(!set.contains(GeoID(GeoID::SystemType::kPDS, 2, 0)));
+
+  BOOST_REQUIRE(set.erase(GeoID(GeoID::SystemType::kTPC, 1, 130)));
+  BOOST_REQUIRE(!set.erase(GeoID(GeoID::SystemType::kTPC, 1, 130)));
+  BOOST_REQUIRE_EQUAL(set.size(), 2);
+
+  std::vector<GeoID> expected{ GeoID(GeoID::SystemType::kTPC, 2, 130), GeoID(GeoID::SystemType::kPDS, 1, 0) };
+  BOOST_REQUIRE(set.to_vector() == expected);
+
+  BOOST_REQUIRE_EXCEPTION(set.insert(GeoID(GeoID::SystemType::kTPC, 1, GeoIDSet::s_max_element_id + 1)),
+                          dunedaq::dataformats::GeoIDSetElementError,
+                          [&](dunedaq::dataformats::GeoIDSetElementError) { return true; });
+
+  set.clear();
+  BOOST_REQUIRE(set.empty());
+}
+
+/**
+ * @brief Test union, intersection and difference against std::set
+ */
+BOOST_AUTO_TEST_CASE(SetOperations)
+{
+  GeoIDSet first, second;
+  std::set<GeoID> first_ref, second_ref;
+  for (uint32_t idx = 0; idx < 300; ++idx) { // NOLINT(build/unsigned)
+    GeoID id(GeoID::SystemType::kTPC, idx % 3, idx);
+    if (idx % 2 == 0) {
+      first.insert(id);
+      first_ref.insert(id);
+    }
+    if (idx % 5 == 0 && idx < 200) {
+      second.insert(id);
+      second_ref.insert(id);
+    }
+  }
+  second.insert(GeoID(GeoID::SystemType::kPDS, 0, 7));
+  second_ref.insert(GeoID(GeoID::SystemType::kPDS, 0, 7));
+
+  std::set<GeoID> expected;
+  std::set_union(first_ref.begin(), first_ref.end(), second_ref.begin(), second_ref.end(),
+                 std::inserter(expected, expected.end()));
+  auto result = first | second;
+  BOOST_REQUIRE(result.to_vector() == std::vector<GeoID>(expected.begin(), expected.end()));
+  BOOST_REQUIRE_EQUAL(result.size(), expected.size());
+
+  expected.clear();
+  std::set_intersection(first_ref.begin(), first_ref.end(), second_ref.begin(), second_ref.end(),
+                        std::inserter(expected, expected.end()));
+  result = first & second;
+  BOOST_REQUIRE(result.to_vector() == std::vector<GeoID>(expected.begin(), expected.end()));
+
+  expected.clear();
+  std::set_difference(first_ref.begin(), first_ref.end(), second_ref.begin(), second_ref.end(),
+                      std::inserter(expected, expected.end()));
+  result = first - second;
+  BOOST_REQUIRE(result.to_vector() == std::vector<GeoID>(expected.begin(), expected.end()));
+
+  BOOST_REQUIRE((second - (first | second)).empty());
+}
+
+/**
+ * @brief Test building sets from TriggerRecordHeader components and from Fragments
+ */
+BOOST_AUTO_TEST_CASE(FromComponentsAndFragments)
+{
+  std::vector<ComponentRequest> components;
+  components.emplace_back(GeoID(GeoID::SystemType::kTPC, 0, 1), 0, 1);
+  components.emplace_back(GeoID(GeoID::SystemType::kTPC, 0, 2), 0, 1);
+  components.emplace_back(GeoID(GeoID::SystemType::kTPC, 0, 1), 2, 3);
+  TriggerRecordHeader header(components);
+
+  GeoIDSet duplicates;
+  auto requested = GeoIDSet::from_components(header, &duplicates);
+  BOOST_REQUIRE_EQUAL(requested.size(), 2);
+  BOOST_REQUIRE(duplicates.to_vector() == std::vector<GeoID>{ GeoID(GeoID::SystemType::kTPC, 0, 1) });
+
+  std::vector<std::unique_ptr<Fragment>> fragments;
+  fragments.push_back(std::make_unique<Fragment>(Fragment::create_empty(FragmentHeader())));
+  fragments.back()->set_element_id(GeoID(GeoID::SystemType::kTPC, 0, 2));
+  auto received = GeoIDSet::from_fragments(fragments);
+
+  auto missing = requested - received;
+  BOOST_REQUIRE(missing.to_vector() == std::vector<GeoID>{ GeoID(GeoID::SystemType::kTPC, 0, 1) });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
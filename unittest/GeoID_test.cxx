@@ -18,6 +18,7 @@
 #include <functional>
 #include <sstream>
 #include <string>
+#include <system_error>
 #include <vector>
 
 using namespace dunedaq::dataformats;
@@ -92,4 +93,67 @@ BOOST_AUTO_TEST_CASE(ComparisonOperator)
   BOOST_REQUIRE(!(greater < lesser));
 }
 
+/**
+ * @brief Test that the GeoID key round-trips and preserves the field ordering
+ */
+BOOST_AUTO_TEST_CASE(Key)
+{
+  constexpr GeoID test(GeoID::SystemType::kNDLArTPC, 0xFFFF, 0xFFFFFFFF);
+  static_assert(GeoID::from_key(test.get_key()) == test);
+  static_assert(test.get_key() == 0x0004FFFFFFFFFFFFULL);
+
+  std::vector<GeoID> ids{ GeoID(GeoID::SystemType::kTPC, 1, 2),
+                          GeoID(GeoID::SystemType::kTPC, 1, 3),
+                          GeoID(GeoID::SystemType::kTPC, 2, 0),
+                          GeoID(GeoID::SystemType::kPDS, 0, 0) };
+  for (size_t idx = 0; idx < ids.size(); ++idx) {
+    BOOST_REQUIRE_EQUAL(GeoID::from_key(ids[idx].get_key()), ids[idx]);
+    for (size_t other = 0; other < ids.size(); ++other) {
+      BOOST_REQUIRE_EQUAL(ids[idx] < ids[other], idx < other);
+      BOOST_REQUIRE_EQUAL(ids[idx] == ids[other], idx == other);
+    }
+  }
+}
+
+/**
+ * @brief Test that std::hash<GeoID> distinguishes GeoIDs differing in any field
+ */
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  std::hash<GeoID> hasher;
+  GeoID test(GeoID::SystemType::kTPC, 1, 2);
+  BOOST_REQUIRE_EQUAL(hasher(test), hasher(GeoID(GeoID::SystemType::kTPC, 1, 2)));
+  BOOST_REQUIRE_NE(hasher(test), hasher(GeoID(GeoID::SystemType::kPDS, 1, 2)));
+  BOOST_REQUIRE_NE(hasher(test), hasher(GeoID(GeoID::SystemType::kTPC, 2, 2)));
+  BOOST_REQUIRE_NE(hasher(test), hasher(GeoID(GeoID::SystemType::kTPC, 1, 3)));
+}
+
+/**
+ * @brief Test that to_chars and from_chars match the stream operators
+ */
+BOOST_AUTO_TEST_CASE(CharConversion)
+{
+  GeoID test(GeoID::SystemType::kDataSelection, 12, 345678);
+  std::ostringstream ostr;
+  ostr << test;
+
+  char buffer[64];
+  auto [end, ec] = to_chars(buffer, buffer + sizeof(buffer), test);
+  BOOST_REQUIRE(ec == std::errc());
+  BOOST_REQUIRE_EQUAL(std::string(buffer, end), ostr.str());
+
+  GeoID parsed;
+  auto result = from_chars(buffer, end, parsed);
+  BOOST_REQUIRE(result.ec == std::errc());
+  BOOST_REQUIRE(result.ptr == end);
+  BOOST_REQUIRE_EQUAL(parsed, test);
+
+  BOOST_REQUIRE(to_chars(buffer, buffer + 10, test).ec == std::errc::value_too_large);
+  BOOST_REQUIRE(from_chars(buffer, buffer + 10, parsed).ec == std::errc::invalid_argument);
+
+  BOOST_REQUIRE_EQUAL(GeoID::string_to_system_type(std::string_view("NDLArTPC,")), GeoID::SystemType::kNDLArTPC);
+  BOOST_REQUIRE_EQUAL(GeoID::string_to_system_type(std::string_view("TP")), GeoID::SystemType::kInvalid);
+  BOOST_REQUIRE_EQUAL(GeoID::string_to_system_type(std::string_view()), GeoID::SystemType::kInvalid);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
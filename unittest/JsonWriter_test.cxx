@@ -0,0 +1,120 @@
+/**
+ * @file JsonWriter_test.cxx JsonWriter class Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/JsonWriter.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE JsonWriter_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+BOOST_AUTO_TEST_SUITE(JsonWriter_test)
+
+/**
+ * @brief Test writing structs with a FieldTable
+ */
+BOOST_AUTO_TEST_CASE(Structs)
+{
+  JsonWriter writer(16);
+  writer.write(GeoID(GeoID::SystemType::kTPC, 1, 2));
+  BOOST_REQUIRE_EQUAL(writer.view(), R"({"type":"TPC","region":1,"element":2})");
+
+  writer.clear();
+  writer.write(ComponentRequest(GeoID(GeoID::SystemType::kPDS, 3, 4), 5, 6)).newline();
+  BOOST_REQUIRE_EQUAL(writer.view(),
+                      "{\"component\":{\"type\":\"PDS\",\"region\":3,\"element\":4},\"begin\":5,\"end\":6}\n");
+
+  writer.clear();
+  FragmentHeader header;
+  header.size = 100;
+  header.trigger_number = 7;
+  header.run_number = 8;
+  header.trigger_timestamp = 9;
+  header.window_begin = 10;
+  header.window_end = 11;
+  header.element_id = GeoID(GeoID::SystemType::kNDLArTPC, 12, 13);
+  header.error_bits = 14;
+  header.fragment_type = 3;
+  header.sequence_number = 15;
+  writer.write(header);
+  BOOST_REQUIRE_EQUAL(writer.view(),
+                      "{\"check_word\":" + std::to_string(FragmentHeader::s_fragment_header_magic) +
+                        ",\"version\":" + std::to_string(FragmentHeader::s_fragment_header_version) +
+                        ",\"size\":100,\"trigger_number\":7,\"run_number\":8,\"trigger_timestamp\":9,"
+                        "\"window_begin\":10,\"window_end\":11,"
+                        "\"element_id\":{\"type\":\"NDLArTPC\",\"region\":12,\"element\":13},"
+                        "\"error_bits\":14,\"fragment_type\":3,\"sequence_number\":15}");
+}
+
+/**
+ * @brief Test that numbers of every length are written as std::to_string writes them
+ */
+BOOST_AUTO_TEST_CASE(Numbers)
+{
+  JsonWriter writer;
+  for (timestamp_t value = 1; value < std::numeric_limits<timestamp_t>::max() / 7; value *= 7) {
+    ComponentRequest request(GeoID(), value - 1, value);
+    writer.clear();
+    writer.write(request);
+    auto text = std::string(writer.view());
+    BOOST_REQUIRE(text.find("\"begin\":" + std::to_string(value - 1) + ",\"end\":" + std::to_string(value) + "}") !=
+                  std::string::npos);
+  }
+
+  writer.clear();
+  writer.write(ComponentRequest());
+  auto max_text = std::to_string(std::numeric_limits<timestamp_t>::max());
+  BOOST_REQUIRE(std::string(writer.view()).find("\"begin\":" + max_text + ",\"end\":" + max_text + "}") !=
+                std::string::npos);
+}
+
+/**
+ * @brief Test writing a TriggerRecordHeader and a TriggerRecord summary
+ */
+BOOST_AUTO_TEST_CASE(TriggerRecords)
+{
+  std::vector<ComponentRequest> components;
+  components.emplace_back(GeoID(GeoID::SystemType::kTPC, 0, 1), 2, 3);
+  components.emplace_back(GeoID(GeoID::SystemType::kTPC, 0, 4), 5, 6);
+  TriggerRecord record(components);
+
+  JsonWriter writer;
+  writer.write(record.get_header_ref());
+  auto text = std::string(writer.view());
+  BOOST_REQUIRE_EQUAL(text.find("{\"header\":{\"check_word\":"), 0);
+  BOOST_REQUIRE(text.find(",\"components\":[{\"component\":{\"type\":\"TPC\",\"region\":0,\"element\":1},"
+                          "\"begin\":2,\"end\":3},{") != std::string::npos);
+
+  std::vector<char> payload(300);
+  record.add_fragment(std::make_unique<Fragment>(payload.data(), payload.size()));
+  record.get_fragments_ref().back()->set_type(FragmentType::kTPCData);
+  record.add_fragment(std::make_unique<Fragment>(Fragment::create_empty(FragmentHeader())));
+  record.get_fragments_ref().back()->set_type(FragmentType::kTPCData);
+  record.add_fragment(std::make_unique<Fragment>(payload.data(), 10));
+  record.get_fragments_ref().back()->set_type(FragmentType::kTriggerPrimitives);
+  record.get_fragments_ref().back()->set_error_bit(FragmentErrorBits::kIncomplete, true);
+
+  writer.clear();
+  writer.write(record);
+  text = std::string(writer.view());
+  auto expected_size = 3 * sizeof(FragmentHeader) + payload.size() + 10;
+  BOOST_REQUIRE(text.find(",\"num_fragments\":3,\"total_fragment_size\":" + std::to_string(expected_size) +
+                          ",\"fragment_counts\":{\"TPC\":2,\"TriggerPrimitives\":1},"
+                          "\"num_fragments_with_errors\":2,\"fragment_error_bits\":3}") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
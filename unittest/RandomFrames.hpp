@@ -0,0 +1,44 @@
+/**
+ * @file RandomFrames.hpp Random frames shared by the frame Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#ifndef DATAFORMATS_UNITTEST_RANDOMFRAMES_HPP_
+#define DATAFORMATS_UNITTEST_RANDOMFRAMES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace dunedaq {
+namespace dataformats {
+
+/**
+ * @brief Make frames whose every byte, headers included, is random
+ * @tparam Frame Trivially-copyable frame type, e.g. WIBFrame or WIB2Frame
+ * @param num_frames Number of frames
+ * @param seed Seed of the random generator, so that each test has its own reproducible data
+ * @return The frames
+ */
+template<typename Frame>
+std::vector<Frame>
+make_random_frames(size_t num_frames, std::mt19937::result_type seed)
+{
+  std::vector<Frame> frames(num_frames);
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> byte(0, 255);
+  auto* bytes = reinterpret_cast<uint8_t*>(frames.data()); // NOLINT
+  for (size_t i = 0; i < num_frames * sizeof(Frame); ++i) {
+    bytes[i] = byte(gen);
+  }
+  return frames;
+}
+
+} // namespace dataformats
+} // namespace dunedaq
+
+#endif // DATAFORMATS_UNITTEST_RANDOMFRAMES_HPP_
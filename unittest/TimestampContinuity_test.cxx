@@ -0,0 +1,138 @@
+/**
+ * @file TimestampContinuity_test.cxx Timestamp continuity checker Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/TimestampContinuity.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE TimestampContinuity_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+std::vector<WIBFrame>
+make_wib_frames(size_t num_frames, timestamp_t first_timestamp)
+{
+  std::vector<WIBFrame> frames(num_frames);
+  std::memset(frames.data(), 0, num_frames * sizeof(WIBFrame));
+  for (size_t i = 0; i < num_frames; ++i) {
+    frames[i].set_timestamp(first_timestamp + i * FrameTimestampStep<WIBFrame>::value);
+  }
+  return frames;
+}
+
+void
+set_wib2_timestamp(WIB2Frame& frame, timestamp_t timestamp)
+{
+  frame.header.timestamp_1 = timestamp;
+  frame.header.timestamp_2 = timestamp >> 32;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(TimestampContinuity_test)
+
+BOOST_AUTO_TEST_CASE(Continuous)
+{
+  // Longer than one block of the checker
+  auto frames = make_wib_frames(300, 0x123456789);
+  auto report = check_timestamp_continuity(frames.data(), frames.size());
+  BOOST_REQUIRE(report.is_continuous());
+  BOOST_REQUIRE_EQUAL(report.num_frames, 300);
+  BOOST_REQUIRE_EQUAL(report.first_discontinuity, 300);
+
+  BOOST_REQUIRE(check_timestamp_continuity(frames.data(), 0).is_continuous());
+  BOOST_REQUIRE(check_timestamp_continuity(frames.data(), 1).is_continuous());
+
+  // The same frames with a different step are all irregular
+  report = check_timestamp_continuity(frames.data(), frames.size(), 50);
+  BOOST_REQUIRE_EQUAL(report.num_irregular_steps, 299);
+  BOOST_REQUIRE_EQUAL(report.first_discontinuity, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Discontinuities)
+{
+  auto frames = make_wib_frames(300, 1000000);
+  // Two missing frames before frame 70, at a block boundary of the checker
+  for (size_t i = 65; i < frames.size(); ++i) {
+    frames[i].set_timestamp(frames[i].get_timestamp() + 2 * 25);
+  }
+  // A duplicate of frame 100
+  frames[101].set_timestamp(frames[100].get_timestamp());
+  // Frame 200 from the past: out of order going into it, then a gap coming out of it
+  frames[200].set_timestamp(frames[10].get_timestamp());
+  // A short step before frame 299
+  frames[299].set_timestamp(frames[298].get_timestamp() + 7);
+
+  std::vector<size_t> indices;
+  auto count = for_each_timestamp_discontinuity(
+    frames.data(), frames.size(), 25, [&](size_t index, timestamp_t, timestamp_t) { indices.push_back(index); });
+  BOOST_REQUIRE_EQUAL(count, indices.size());
+  BOOST_REQUIRE(indices == (std::vector<size_t>{ 65, 101, 102, 200, 201, 299 }));
+
+  auto report = check_timestamp_continuity(frames.data(), frames.size());
+  BOOST_REQUIRE(!report.is_continuous());
+  BOOST_REQUIRE_EQUAL(report.first_discontinuity, 65);
+  // Frame 102 is two steps after the duplicate, and frame 201 193 steps after frame 200 (with the earlier gap)
+  BOOST_REQUIRE_EQUAL(report.num_gaps, 3);
+  BOOST_REQUIRE_EQUAL(report.num_missing_frames, 2 + 1 + 192);
+  BOOST_REQUIRE_EQUAL(report.num_duplicates, 1);
+  BOOST_REQUIRE_EQUAL(report.num_out_of_order, 1);
+  BOOST_REQUIRE_EQUAL(report.num_irregular_steps, 1);
+}
+
+BOOST_AUTO_TEST_CASE(WIB2Frames)
+{
+  std::vector<WIB2Frame> frames(100);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    set_wib2_timestamp(frames[i], 0xFFFFFF00 + i * 32);
+  }
+  BOOST_REQUIRE(check_timestamp_continuity(frames.data(), frames.size()).is_continuous());
+
+  set_wib2_timestamp(frames[50], frames[50].get_timestamp() + 32 * 4);
+  auto report = check_timestamp_continuity(frames.data(), frames.size());
+  BOOST_REQUIRE_EQUAL(report.num_gaps, 1);
+  BOOST_REQUIRE_EQUAL(report.num_missing_frames, 4);
+  BOOST_REQUIRE_EQUAL(report.num_out_of_order, 1);
+}
+
+BOOST_AUTO_TEST_CASE(Fragments)
+{
+  auto frames = make_wib_frames(20, 5000);
+  Fragment continuous(frames.data(), frames.size() * sizeof(WIBFrame));
+  auto report = check_timestamp_continuity<WIBFrame>(continuous);
+  BOOST_REQUIRE(report.is_continuous());
+  BOOST_REQUIRE_EQUAL(report.num_frames, 20);
+  BOOST_REQUIRE(!continuous.get_error_bit(FragmentErrorBits::kIncomplete));
+
+  frames.erase(frames.begin() + 7);
+  Fragment missing(frames.data(), frames.size() * sizeof(WIBFrame));
+  report = check_timestamp_continuity<WIBFrame>(missing, FrameTimestampStep<WIBFrame>::value, false);
+  BOOST_REQUIRE_EQUAL(report.num_missing_frames, 1);
+  BOOST_REQUIRE(!missing.get_error_bit(FragmentErrorBits::kIncomplete));
+  report = check_timestamp_continuity<WIBFrame>(missing);
+  BOOST_REQUIRE_EQUAL(report.first_discontinuity, 7);
+  BOOST_REQUIRE(missing.get_error_bit(FragmentErrorBits::kIncomplete));
+
+  // Duplicates alone do not make a Fragment incomplete
+  frames = make_wib_frames(20, 5000);
+  frames.insert(frames.begin() + 3, frames[2]);
+  Fragment duplicated(frames.data(), frames.size() * sizeof(WIBFrame));
+  report = check_timestamp_continuity<WIBFrame>(duplicated);
+  BOOST_REQUIRE_EQUAL(report.num_duplicates, 1);
+  BOOST_REQUIRE(!duplicated.get_error_bit(FragmentErrorBits::kIncomplete));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
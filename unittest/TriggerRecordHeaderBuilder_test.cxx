@@ -0,0 +1,188 @@
+/**
+ * @file TriggerRecordHeaderBuilder_test.cxx TriggerRecordHeaderBuilder class Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/TriggerRecordHeaderBuilder.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE TriggerRecordHeaderBuilder_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <list>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+BOOST_AUTO_TEST_SUITE(TriggerRecordHeaderBuilder_test)
+
+/**
+ * @brief Check that TriggerRecordHeaderBuilders have appropriate Copy/Move semantics
+ */
+BOOST_AUTO_TEST_CASE(CopyAndMoveSemantics)
+{
+  BOOST_REQUIRE(!std::is_copy_constructible_v<TriggerRecordHeaderBuilder>);
+  BOOST_REQUIRE(!std::is_copy_assignable_v<TriggerRecordHeaderBuilder>);
+  BOOST_REQUIRE(std::is_nothrow_move_constructible_v<TriggerRecordHeaderBuilder>);
+  BOOST_REQUIRE(std::is_nothrow_move_assignable_v<TriggerRecordHeaderBuilder>);
+}
+
+/**
+ * @brief Check that ComponentRequests can be added one at a time
+ */
+BOOST_AUTO_TEST_CASE(EmplaceComponents)
+{
+  TriggerRecordHeaderBuilder builder(2);
+  BOOST_REQUIRE_EQUAL(builder.capacity(), 2);
+
+  builder.emplace_back(GeoID(GeoID::SystemType::kTPC, 1, 2), 3, 4);
+  builder.push_back(ComponentRequest(GeoID(GeoID::SystemType::kTPC, 5, 6), 7, 8));
+  builder.emplace_back().window_begin = 11;
+  BOOST_REQUIRE_EQUAL(builder.size(), 3);
+  BOOST_REQUIRE(builder.capacity() >= 3);
+  BOOST_REQUIRE_EQUAL(builder[1].window_end, 8);
+  BOOST_REQUIRE_THROW(builder[3], dunedaq::dataformats::ComponentRequestIndexError);
+
+  auto header = builder.build();
+  BOOST_REQUIRE_EQUAL(builder.size(), 0);
+  BOOST_REQUIRE_EQUAL(header.get_num_requested_components(), 3);
+  BOOST_REQUIRE_EQUAL(header.get_total_size_bytes(), sizeof(TriggerRecordHeaderData) + 3 * sizeof(ComponentRequest));
+  BOOST_REQUIRE_EQUAL(header.get_header().trigger_record_header_marker,
+                      TriggerRecordHeaderData::s_trigger_record_header_magic);
+  BOOST_REQUIRE_EQUAL(header.at(0).component.region_id, 1);
+  BOOST_REQUIRE_EQUAL(header.at(0).window_begin, 3);
+  BOOST_REQUIRE_EQUAL(header.at(1).component.element_id, 6);
+  BOOST_REQUIRE_EQUAL(header.at(2).window_begin, 11);
+
+  // The header owns the data array, so copies and setters behave as for any other TriggerRecordHeader
+  header.set_run_number(12);
+  TriggerRecordHeader copy_header(header);
+  BOOST_REQUIRE_EQUAL(copy_header.get_run_number(), 12);
+  BOOST_REQUIRE_EQUAL(copy_header.at(1).window_begin, 7);
+
+  // The builder can be reused after build()
+  builder.emplace_back(GeoID(GeoID::SystemType::kPDS, 1, 1), 1, 2);
+  auto second_header = builder.build();
+  BOOST_REQUIRE_EQUAL(second_header.get_num_requested_components(), 1);
+  BOOST_REQUIRE_EQUAL(second_header.at(0).component.system_type, GeoID::SystemType::kPDS);
+}
+
+/**
+ * @brief Check the bulk append methods
+ */
+BOOST_AUTO_TEST_CASE(AppendComponents)
+{
+  std::vector<ComponentRequest> components;
+  for (uint32_t i = 0; i < 100; ++i) { // NOLINT(build/unsigned)
+    components.emplace_back(GeoID(GeoID::SystemType::kTPC, 0, i), i, i + 1);
+  }
+  std::list<ComponentRequest> component_list(components.begin(), components.begin() + 10);
+
+  TriggerRecordHeaderBuilder builder;
+  builder.append(components.data(), 50);
+  builder.append(components.begin() + 50, components.end());
+  builder.append(component_list.begin(), component_list.end());
+  builder.append(components.data(), 0);
+  BOOST_REQUIRE_EQUAL(builder.size(), 110);
+
+  auto header = builder.build();
+  BOOST_REQUIRE_EQUAL(header.get_num_requested_components(), 110);
+  for (size_t i = 0; i < 110; ++i) {
+    BOOST_REQUIRE_EQUAL(header[i].component.element_id, i % 100);
+    BOOST_REQUIRE_EQUAL(header[i].window_end, i % 100 + 1);
+  }
+
+  TriggerRecordHeader vector_header(components);
+  BOOST_REQUIRE_EQUAL(vector_header.get_num_requested_components(), 100);
+  BOOST_REQUIRE_EQUAL(memcmp(static_cast<const uint8_t*>(vector_header.get_storage_location()) + // NOLINT
+                               sizeof(TriggerRecordHeaderData),
+                             static_cast<const uint8_t*>(header.get_storage_location()) + // NOLINT
+                               sizeof(TriggerRecordHeaderData),
+                             100 * sizeof(ComponentRequest)),
+                      0);
+}
+
+/**
+ * @brief Check that the builder's own ComponentRequests can be added again when the data array is full
+ */
+BOOST_AUTO_TEST_CASE(AppendOwnComponents)
+{
+  TriggerRecordHeaderBuilder builder(2);
+  builder.emplace_back(GeoID(GeoID::SystemType::kTPC, 1, 0), 10, 11);
+  builder.emplace_back(GeoID(GeoID::SystemType::kTPC, 1, 1), 20, 21);
+
+  BOOST_REQUIRE_EQUAL(builder.size(), builder.capacity());
+  builder.push_back(builder[0]);
+  BOOST_REQUIRE_EQUAL(builder.size(), builder.capacity() - 1);
+  builder.emplace_back(builder[1]);
+
+  BOOST_REQUIRE_EQUAL(builder.size(), builder.capacity());
+  builder.append(&builder[0], builder.size());
+  BOOST_REQUIRE_EQUAL(builder.size(), builder.capacity());
+  const ComponentRequest* first = &builder[0];
+  builder.append(first, first + builder.size());
+  BOOST_REQUIRE_EQUAL(builder.size(), 16);
+
+  auto header = builder.build();
+  for (size_t i = 0; i < 16; ++i) {
+    BOOST_REQUIRE_EQUAL(header[i].component.element_id, i % 2);
+    BOOST_REQUIRE_EQUAL(header[i].window_begin, 10 * (i % 2 + 1));
+    BOOST_REQUIRE_EQUAL(header[i].window_end, 10 * (i % 2 + 1) + 1);
+  }
+}
+
+/**
+ * @brief Check that the builder can sort the components when finalizing the TriggerRecordHeader
+ */
+BOOST_AUTO_TEST_CASE(SortedBuild)
+{
+  TriggerRecordHeaderBuilder builder(10);
+  for (uint32_t i = 0; i < 10; ++i) { // NOLINT(build/unsigned)
+    builder.emplace_back(GeoID(GeoID::SystemType::kTPC, 0, 10 - i), i, i + 1);
+  }
+
+  auto header = builder.build(true);
+  BOOST_REQUIRE(header.are_components_sorted());
+  BOOST_REQUIRE_EQUAL(header[0].component.element_id, 1);
+  BOOST_REQUIRE_EQUAL(header.find(GeoID(GeoID::SystemType::kTPC, 0, 3))->window_begin, 7);
+}
+
+/**
+ * @brief Check that the header fields can be given before building, except the number of components
+ */
+BOOST_AUTO_TEST_CASE(SetHeader)
+{
+  TriggerRecordHeaderData header_data;
+  header_data.trigger_number = 3;
+  header_data.num_requested_components = 99;
+  TriggerRecordHeaderBuilder builder;
+  builder.emplace_back();
+  builder.set_header(header_data);
+  builder.emplace_back();
+  auto header = builder.build();
+  BOOST_REQUIRE_EQUAL(header.get_trigger_number(), 3);
+  BOOST_REQUIRE_EQUAL(header.get_num_requested_components(), 2);
+}
+
+/**
+ * @brief Check that an empty builder produces a valid TriggerRecordHeader
+ */
+BOOST_AUTO_TEST_CASE(EmptyBuilder)
+{
+  TriggerRecordHeaderBuilder builder;
+  auto header = builder.build();
+  BOOST_REQUIRE_EQUAL(header.get_num_requested_components(), 0);
+  BOOST_REQUIRE_EQUAL(header.get_total_size_bytes(), sizeof(TriggerRecordHeaderData));
+
+  TriggerRecordHeaderBuilder moved_builder(std::move(builder));
+  moved_builder.emplace_back();
+  BOOST_REQUIRE_EQUAL(moved_builder.build().get_num_requested_components(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
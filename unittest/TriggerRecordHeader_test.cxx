@@ -26,9 +26,12 @@
 
 #include "boost/test/unit_test.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace dunedaq::dataformats;
@@ -44,6 +47,32 @@ BOOST_AUTO_TEST_CASE(CopyAndMoveSemantics)
   BOOST_REQUIRE(std::is_copy_assignable_v<TriggerRecordHeader>);
   BOOST_REQUIRE(std::is_move_constructible_v<TriggerRecordHeader>);
   BOOST_REQUIRE(std::is_move_assignable_v<TriggerRecordHeader>);
+  BOOST_REQUIRE(std::is_nothrow_move_constructible_v<TriggerRecordHeader>);
+  BOOST_REQUIRE(std::is_nothrow_move_assignable_v<TriggerRecordHeader>);
+}
+
+/**
+ * @brief Check that moving a TriggerRecordHeader transfers ownership of its data array
+ */
+BOOST_AUTO_TEST_CASE(MoveOwnership)
+{
+  std::vector<ComponentRequest> components(2);
+  components[1].window_begin = 7;
+
+  TriggerRecordHeader header(components);
+  header.set_run_number(9);
+  auto storage = header.get_storage_location();
+
+  TriggerRecordHeader moved_header(std::move(header));
+  BOOST_REQUIRE_EQUAL(moved_header.get_storage_location(), storage);
+  BOOST_REQUIRE_EQUAL(moved_header.get_run_number(), 9);
+  BOOST_REQUIRE(header.get_storage_location() == nullptr); // NOLINT(bugprone-use-after-move)
+
+  TriggerRecordHeader assigned_header(components);
+  assigned_header = std::move(moved_header);
+  BOOST_REQUIRE_EQUAL(assigned_header.get_storage_location(), storage);
+  BOOST_REQUIRE_EQUAL(assigned_header[1].window_begin, 7);
+  BOOST_REQUIRE(moved_header.get_storage_location() == nullptr); // NOLINT(bugprone-use-after-move)
 }
 
 /**
@@ -223,6 +252,84 @@ BOOST_AUTO_TEST_CASE(HeaderFields)
   BOOST_REQUIRE_EQUAL(header_ptr->error_bits, 0x11111111);
 }
 
+/**
+ * @brief Test iteration over and lookup of ComponentRequests
+ */
+BOOST_AUTO_TEST_CASE(FindComponents)
+{
+  std::vector<ComponentRequest> components;
+  for (uint32_t i = 0; i < 20; ++i) { // NOLINT(build/unsigned)
+    // Insert in descending order to exercise the sort
+    components.emplace_back(GeoID(GeoID::SystemType::kTPC, 1 + i % 2, 20 - i), i, i + 1);
+  }
+  components.emplace_back(GeoID(GeoID::SystemType::kPDS, 0, 0), 100, 101);
+
+  TriggerRecordHeader header(components);
+  BOOST_REQUIRE(!header.are_components_sorted());
+  BOOST_REQUIRE_EQUAL(header.end() - header.begin(), 21);
+
+  size_t count = 0;
+  for (auto const& component : header) {
+    BOOST_REQUIRE_EQUAL(component.window_begin, components[count].window_begin);
+    ++count;
+  }
+  BOOST_REQUIRE_EQUAL(count, 21);
+
+  auto missing = GeoID(GeoID::SystemType::kTPC, 3, 1);
+  auto present = GeoID(GeoID::SystemType::kTPC, 2, 11);
+
+  // Linear search
+  BOOST_REQUIRE(header.find(missing) == header.end());
+  BOOST_REQUIRE(header.find(present) != header.end());
+  BOOST_REQUIRE_EQUAL(header.find(present)->window_begin, 9);
+
+  // Binary search
+  header.sort_components();
+  BOOST_REQUIRE(header.are_components_sorted());
+  BOOST_REQUIRE(std::is_sorted(
+    header.begin(), header.end(), [](auto const& a, auto const& b) { return a.component < b.component; }));
+  BOOST_REQUIRE(header.find(missing) == header.end());
+  for (auto const& component : components) {
+    auto it = header.find(component.component);
+    BOOST_REQUIRE(it != header.end());
+    BOOST_REQUIRE_EQUAL(it->window_begin, component.window_begin);
+  }
+
+  // The ordering survives copies but not modification
+  TriggerRecordHeader copy_header(header);
+  BOOST_REQUIRE(copy_header.are_components_sorted());
+  copy_header[0].component = missing;
+  BOOST_REQUIRE(!copy_header.are_components_sorted());
+  BOOST_REQUIRE(copy_header.find(missing) == copy_header.begin());
+}
+
+/**
+ * @brief Test the unchecked and non-throwing ComponentRequest accessors
+ */
+BOOST_AUTO_TEST_CASE(UncheckedComponents)
+{
+  std::vector<ComponentRequest> components;
+  for (uint32_t i = 0; i < 5; ++i) { // NOLINT(build/unsigned)
+    components.emplace_back(GeoID(GeoID::SystemType::kTPC, 1, i), 10 * i, 10 * i + 5);
+  }
+  TriggerRecordHeader header(components);
+  header.sort_components();
+
+  for (size_t i = 0; i < components.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(header.get_component_unchecked(i).window_begin, components[i].window_begin);
+    ComponentRequest request;
+    BOOST_REQUIRE(header.try_get_component(i, request));
+    BOOST_REQUIRE(request.component == components[i].component);
+    BOOST_REQUIRE_EQUAL(request.window_end, components[i].window_end);
+  }
+  // Unlike operator[], the read-only accessors keep the ordering
+  BOOST_REQUIRE(header.are_components_sorted());
+
+  ComponentRequest request(GeoID(GeoID::SystemType::kPDS, 2, 3), 1, 2);
+  BOOST_REQUIRE(!header.try_get_component(components.size(), request));
+  BOOST_REQUIRE_EQUAL(request.window_begin, 1);
+}
+
 BOOST_AUTO_TEST_CASE(StreamOperator)
 {
   std::vector<ComponentRequest> components;
@@ -264,4 +371,51 @@ BOOST_AUTO_TEST_CASE(StreamOperator)
   BOOST_REQUIRE_EQUAL(trhd.num_requested_components, header_data.num_requested_components);
 }
 
+/**
+ * @brief Test that atomic error bit updates from several threads are not lost
+ */
+BOOST_AUTO_TEST_CASE(AtomicErrorBits)
+{
+  TriggerRecordHeader obj(std::vector<ComponentRequest>{});
+  // Every thread flips its own bits many times and finally sets them; a lost update would leave a bit clear
+  constexpr size_t num_threads = 8;
+  std::vector<std::thread> threads;
+  for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    threads.emplace_back([&, thread_idx]() {
+      for (int iter = 0; iter < 10000; ++iter) {
+        for (size_t bit = thread_idx; bit < 32; bit += num_threads) {
+          obj.atomic_set_error_bit(static_cast<TriggerRecordErrorBits>(bit), iter % 2 == 0);
+        }
+      }
+      for (size_t bit = thread_idx; bit < 32; bit += num_threads) {
+        obj.atomic_set_error_bit(static_cast<TriggerRecordErrorBits>(bit), true);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_REQUIRE(obj.atomic_get_error_bits().all());
+
+  // Exactly one thread wins a race to set the same bit
+  obj.set_error_bits(0);
+  std::atomic<int> winners{ 0 };
+  threads.clear();
+  for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    threads.emplace_back([&]() {
+      if (!obj.atomic_test_and_set_error_bit(static_cast<TriggerRecordErrorBits>(1))) {
+        ++winners;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  BOOST_REQUIRE_EQUAL(winners.load(), 1);
+  BOOST_REQUIRE(obj.get_error_bit(static_cast<TriggerRecordErrorBits>(1)));
+  BOOST_REQUIRE(obj.atomic_test_and_clear_error_bit(static_cast<TriggerRecordErrorBits>(1)));
+  BOOST_REQUIRE(!obj.atomic_test_and_clear_error_bit(static_cast<TriggerRecordErrorBits>(1)));
+  BOOST_REQUIRE_EQUAL(obj.get_error_bits().to_ulong(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -117,6 +117,17 @@ BOOST_AUTO_TEST_CASE(HeaderManipulation)
   TriggerRecordHeader new_header(components);
   record.set_header(new_header);
   BOOST_REQUIRE_EQUAL(record.get_header_ref().get_num_requested_components(), 3);
+  BOOST_REQUIRE(record.get_header_ref().get_storage_location() != new_header.get_storage_location());
+
+  // Moving a header into the record should hand over its data array instead of copying it
+  auto storage = new_header.get_storage_location();
+  record.set_header(std::move(new_header));
+  BOOST_REQUIRE_EQUAL(record.get_header_ref().get_storage_location(), storage);
+
+  TriggerRecordHeader another_header(components);
+  storage = another_header.get_storage_location();
+  TriggerRecord another_record(std::move(another_header));
+  BOOST_REQUIRE_EQUAL(another_record.get_header_ref().get_storage_location(), storage);
 
   record.get_header_ref().set_trigger_timestamp(100);
   BOOST_REQUIRE_EQUAL(record.get_header_data().trigger_timestamp, 100);
@@ -393,4 +393,49 @@ BOOST_DATA_TEST_CASE(CompareToUnpack, boost::unit_test::data::make(make_vals()),
   BOOST_REQUIRE_EQUAL(num_errors, 0);
 }
 
+BOOST_DATA_TEST_CASE(UncheckedAccessors, boost::unit_test::data::make(make_vals()), vals)
+{
+  WIB2Frame frame;
+  std::memset(&frame, 0, sizeof(frame));
+  for (int i = 0; i < WIB2Frame::s_num_channels; ++i) {
+    frame.set_adc(i, vals[i]);
+  }
+
+  for (int i = 0; i < WIB2Frame::s_num_channels; ++i) {
+    uint16_t value = 0; // NOLINT(build/unsigned)
+    BOOST_REQUIRE(frame.try_get_adc(i, value));
+    BOOST_REQUIRE_EQUAL(value, vals[i]);
+    BOOST_REQUIRE_EQUAL(frame.get_adc_unchecked(i), vals[i]);
+  }
+
+  uint16_t value = 0x123; // NOLINT(build/unsigned)
+  BOOST_REQUIRE(!frame.try_get_adc(-1, value));
+  BOOST_REQUIRE(!frame.try_get_adc(WIB2Frame::s_num_channels, value));
+  BOOST_REQUIRE_EQUAL(value, 0x123);
+}
+
+BOOST_DATA_TEST_CASE(SetAdcOverwrites, boost::unit_test::data::make(make_vals()), vals)
+{
+  // Every bit set, so that values written with OR would come back unchanged
+  WIB2Frame frame;
+  std::memset(&frame, 0xFF, sizeof(frame));
+  for (int i = 0; i < WIB2Frame::s_num_channels; ++i) {
+    frame.set_adc(i, vals[i]);
+  }
+  for (int i = 0; i < WIB2Frame::s_num_channels; ++i) {
+    BOOST_REQUIRE_EQUAL(frame.get_adc(i), vals[i]);
+  }
+  BOOST_REQUIRE_EQUAL(frame.header.start_frame, 0xFFFFFFFF);
+}
+
+BOOST_AUTO_TEST_CASE(Timestamp)
+{
+  WIB2Frame frame;
+  std::memset(&frame, 0, sizeof(frame));
+  frame.set_timestamp(0x0123456789ABCDEF);
+  BOOST_REQUIRE_EQUAL(frame.get_timestamp(), 0x0123456789ABCDEF);
+  BOOST_REQUIRE_EQUAL(frame.header.timestamp_1, 0x89ABCDEF);
+  BOOST_REQUIRE_EQUAL(frame.header.timestamp_2, 0x01234567);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
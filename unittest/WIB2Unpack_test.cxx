@@ -0,0 +1,179 @@
+/**
+ * @file WIB2Unpack_test.cxx WIB2 bulk unpacker Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib2/WIB2Unpack.hpp"
+
+#include "RandomFrames.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE WIB2Unpack_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+const std::vector<wib2::UnpackImplementation> s_implementations = { wib2::UnpackImplementation::kScalar,
+                                                                     wib2::UnpackImplementation::kAVX2,
+                                                                     wib2::UnpackImplementation::kAVX512VBMI };
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(WIB2Unpack_test)
+
+BOOST_AUTO_TEST_CASE(ImplementationNames)
+{
+  BOOST_REQUIRE_EQUAL(std::string(wib2::get_unpack_implementation_name(wib2::UnpackImplementation::kScalar)),
+                      "scalar");
+  BOOST_REQUIRE_EQUAL(std::string(wib2::get_unpack_implementation_name(wib2::UnpackImplementation::kAVX2)), "AVX2");
+  BOOST_REQUIRE_EQUAL(std::string(wib2::get_unpack_implementation_name(wib2::UnpackImplementation::kAVX512VBMI)),
+                      "AVX-512 VBMI");
+
+  BOOST_REQUIRE(wib2::is_unpack_implementation_supported(wib2::UnpackImplementation::kScalar));
+  BOOST_REQUIRE(wib2::is_unpack_implementation_supported(wib2::get_best_unpack_implementation()));
+}
+
+BOOST_AUTO_TEST_CASE(MatchesGetAdc)
+{
+  // The vector is sized exactly, so reading past the last frame would be caught by the address sanitizer
+  const size_t num_frames = 9;
+  auto frames = make_random_frames<WIB2Frame>(num_frames, 4321);
+
+  for (auto implementation : s_implementations) {
+    if (!wib2::is_unpack_implementation_supported(implementation)) {
+      BOOST_TEST_MESSAGE("Skipping unsupported implementation " << wib2::get_unpack_implementation_name(implementation));
+      continue;
+    }
+    std::vector<uint16_t> adcs(num_frames * WIB2Frame::s_num_channels + 1, 0xDEAD); // NOLINT(build/unsigned)
+    wib2::unpack_frames(frames.data(), num_frames, adcs.data(), implementation);
+    BOOST_REQUIRE_EQUAL(adcs.back(), 0xDEAD);
+    for (size_t i = 0; i < num_frames; ++i) {
+      for (int ch = 0; ch < WIB2Frame::s_num_channels; ++ch) {
+        BOOST_REQUIRE_EQUAL(adcs[i * WIB2Frame::s_num_channels + ch], frames[i].get_adc(ch));
+      }
+    }
+  }
+
+  std::vector<uint16_t> adcs(WIB2Frame::s_num_channels); // NOLINT(build/unsigned)
+
+  wib2::unpack_frame(frames[4], adcs.data());
+  for (int ch = 0; ch < WIB2Frame::s_num_channels; ++ch) {
+    BOOST_REQUIRE_EQUAL(adcs[ch], frames[4].get_adc(ch));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PackMatchesSetAdc)
+{
+  // Random values with random bits above the 14 used ones, packed into frames full of random bytes: only the ADC
+  // words must change, and they must not depend on what was there before
+  const size_t num_frames = 7;
+  auto original = make_random_frames<WIB2Frame>(num_frames, 4321);
+  std::vector<uint16_t> values(num_frames * WIB2Frame::s_num_channels); // NOLINT(build/unsigned)
+  std::mt19937 gen(8765);
+  std::uniform_int_distribution<int> value(0, 0xFFFF);
+  for (auto& val : values) {
+    val = value(gen);
+  }
+  auto reference = original;
+  for (size_t i = 0; i < num_frames; ++i) {
+    for (int ch = 0; ch < WIB2Frame::s_num_channels; ++ch) {
+      reference[i].set_adc(ch, values[i * WIB2Frame::s_num_channels + ch] & 0x3FFF);
+    }
+  }
+
+  for (auto implementation : s_implementations) {
+    if (!wib2::is_unpack_implementation_supported(implementation)) {
+      continue;
+    }
+    BOOST_TEST_MESSAGE("Checking implementation " << wib2::get_unpack_implementation_name(implementation));
+    // One extra frame at the end, which must not be written
+    auto frames = original;
+    frames.push_back(original.front());
+    wib2::pack_frames(values.data(), frames.data(), num_frames, implementation);
+    BOOST_REQUIRE_EQUAL(std::memcmp(&frames.back(), &original.front(), sizeof(WIB2Frame)), 0);
+    BOOST_REQUIRE_EQUAL(std::memcmp(frames.data(), reference.data(), num_frames * sizeof(WIB2Frame)), 0);
+  }
+
+  auto frames = original;
+  wib2::pack_frames(values.data(), frames.data(), num_frames);
+  BOOST_REQUIRE_EQUAL(std::memcmp(frames.data(), reference.data(), num_frames * sizeof(WIB2Frame)), 0);
+
+  WIB2Frame frame = original[0];
+  wib2::pack_frame(values.data() + 3 * WIB2Frame::s_num_channels, frame);
+  BOOST_REQUIRE_EQUAL(std::memcmp(&frame.header, &original[0].header, sizeof(WIB2Frame::Header)), 0);
+  BOOST_REQUIRE_EQUAL(std::memcmp(frame.adc_words, reference[3].adc_words, sizeof(frame.adc_words)), 0);
+}
+
+BOOST_AUTO_TEST_CASE(PackRoundTrip)
+{
+  const size_t num_frames = 5;
+  std::vector<uint16_t> values(num_frames * WIB2Frame::s_num_channels); // NOLINT(build/unsigned)
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = (i * 2654435761U >> 18) & 0x3FFF;
+  }
+  auto frames = make_random_frames<WIB2Frame>(num_frames, 4321);
+  std::vector<uint16_t> adcs(values.size()); // NOLINT(build/unsigned)
+  for (auto implementation : s_implementations) {
+    if (!wib2::is_unpack_implementation_supported(implementation)) {
+      continue;
+    }
+    wib2::pack_frames(values.data(), frames.data(), num_frames, implementation);
+    wib2::unpack_frames(frames.data(), num_frames, adcs.data(), implementation);
+    BOOST_REQUIRE(adcs == values);
+    for (int ch = 0; ch < WIB2Frame::s_num_channels; ++ch) {
+      BOOST_REQUIRE_EQUAL(frames[2].get_adc(ch), values[2 * WIB2Frame::s_num_channels + ch]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FillHeaders)
+{
+  auto frames = make_random_frames<WIB2Frame>(4, 4321);
+  auto original = frames;
+  WIB2Frame::Header header = original[3].header;
+  header.crate = 5;
+  header.slot = 3;
+  header.fiber = 1;
+  wib2::fill_headers(frames.data(), 3, header, 0xFFFFFFF0, 32);
+  for (size_t i = 0; i < 3; ++i) {
+    BOOST_REQUIRE_EQUAL(frames[i].header.crate, 5);
+    BOOST_REQUIRE_EQUAL(frames[i].header.slot, 3);
+    BOOST_REQUIRE_EQUAL(frames[i].header.fiber, 1);
+    BOOST_REQUIRE_EQUAL(frames[i].header.start_frame, header.start_frame);
+    BOOST_REQUIRE_EQUAL(frames[i].get_timestamp(), 0xFFFFFFF0 + 32 * i);
+    BOOST_REQUIRE_EQUAL(std::memcmp(frames[i].adc_words, original[i].adc_words, sizeof(frames[i].adc_words)), 0);
+  }
+  BOOST_REQUIRE_EQUAL(std::memcmp(&frames[3], &original[3], sizeof(WIB2Frame)), 0);
+}
+
+BOOST_AUTO_TEST_CASE(UnsupportedImplementation)
+{
+  auto frames = make_random_frames<WIB2Frame>(1, 4321);
+  std::vector<uint16_t> adcs(WIB2Frame::s_num_channels); // NOLINT(build/unsigned)
+  for (auto implementation : s_implementations) {
+    if (wib2::is_unpack_implementation_supported(implementation)) {
+      BOOST_REQUIRE_NO_THROW(wib2::unpack_frames(frames.data(), 1, adcs.data(), implementation));
+      BOOST_REQUIRE_NO_THROW(wib2::pack_frames(adcs.data(), frames.data(), 1, implementation));
+    } else {
+      BOOST_REQUIRE_THROW(wib2::unpack_frames(frames.data(), 1, adcs.data(), implementation),
+                          WIB2UnpackImplementationUnsupported);
+      BOOST_REQUIRE_THROW(wib2::pack_frames(adcs.data(), frames.data(), 1, implementation),
+                          WIB2UnpackImplementationUnsupported);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
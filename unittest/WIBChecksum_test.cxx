@@ -0,0 +1,148 @@
+/**
+ * @file WIBChecksum_test.cxx COLDATA checksum Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBChecksum.hpp"
+
+#include "RandomFrames.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE WIBChecksum_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Byte-by-byte reference for the checksums
+ */
+wib::ColdataChecksums
+reference_checksums(const ColdataBlock& block)
+{
+  const auto* data = reinterpret_cast<const uint8_t*>(&block.segments[0]); // NOLINT
+  wib::ColdataChecksums checksums;
+  for (size_t i = 0; i < sizeof(block.segments); i += 2) {
+    checksums.a += data[i];
+    checksums.b += data[i + 1];
+  }
+  return checksums;
+}
+
+void
+set_link(WIBFrame& frame, int crate, int slot, int fiber)
+{
+  frame.get_wib_header()->crate_no = crate;
+  frame.get_wib_header()->slot_no = slot;
+  frame.get_wib_header()->fiber_no = fiber;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(WIBChecksum_test)
+
+BOOST_AUTO_TEST_CASE(Compute)
+{
+  WIBFrame frame;
+  std::memset(&frame, 0, sizeof(frame));
+  BOOST_REQUIRE(wib::compute_coldata_checksums(frame.get_block(0)) == wib::ColdataChecksums());
+
+  // Channel 0 of ADC 0 is in stream A, channel 0 of ADC 1 in stream B
+  frame.set_channel(1, 0, 0, 0xABC);
+  frame.set_channel(1, 1, 0, 0x123);
+  auto checksums = wib::compute_coldata_checksums(frame.get_block(1));
+  BOOST_REQUIRE_EQUAL(checksums.a, 0xBC + 0xA);
+  BOOST_REQUIRE_EQUAL(checksums.b, 0x23 + 0x1);
+  BOOST_REQUIRE(wib::compute_coldata_checksums(frame.get_block(0)) == wib::ColdataChecksums());
+
+  for (auto& random_frame : make_random_frames<WIBFrame>(20, 97531)) {
+    for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+      BOOST_REQUIRE(wib::compute_coldata_checksums(random_frame.get_block(block)) ==
+                    reference_checksums(random_frame.get_block(block)));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FillAndVerify)
+{
+  auto frames = make_random_frames<WIBFrame>(10, 97531);
+  auto original = frames;
+  wib::fill_coldata_checksums(frames.data(), frames.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(wib::verify_coldata_checksums(frames[i]), 0);
+    for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+      auto expected = reference_checksums(frames[i].get_block(block));
+      BOOST_REQUIRE_EQUAL(frames[i].get_coldata_header(block)->get_checksum_a(), expected.a);
+      BOOST_REQUIRE_EQUAL(frames[i].get_coldata_header(block)->get_checksum_b(), expected.b);
+      // Only the checksums change
+      BOOST_REQUIRE_EQUAL(frames[i].get_coldata_header(block)->coldata_convert_count,
+                          original[i].get_coldata_header(block)->coldata_convert_count);
+    }
+    for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+      BOOST_REQUIRE_EQUAL(frames[i].get_channel(ch), original[i].get_channel(ch));
+    }
+  }
+
+  // Stream A of block 2 and stream B of block 3
+  frames[4].set_channel(2, 4, 0, frames[4].get_channel(2, 4, 0) ^ 0x10);
+  frames[4].set_channel(3, 7, 5, frames[4].get_channel(3, 7, 5) ^ 0x800);
+  BOOST_REQUIRE_EQUAL(wib::verify_coldata_checksums(frames[4]), (1 << 4) | (1 << 7));
+  frames[4].get_coldata_header(0)->set_checksum_b(frames[4].get_coldata_header(0)->get_checksum_b() + 1);
+  BOOST_REQUIRE_EQUAL(wib::verify_coldata_checksums(frames[4]), (1 << 1) | (1 << 4) | (1 << 7));
+}
+
+BOOST_AUTO_TEST_CASE(Summary)
+{
+  auto frames = make_random_frames<WIBFrame>(30, 97531);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    // Runs of frames from two links, then the first one again
+    set_link(frames[i], 1, i < 10 || i >= 25 ? 2 : 3, 1);
+  }
+  wib::fill_coldata_checksums(frames.data(), frames.size());
+  frames[3].get_coldata_header(1)->set_checksum_a(0);
+  frames[3].get_coldata_header(2)->set_checksum_a(0);
+  frames[12].get_coldata_header(0)->set_checksum_b(0);
+  frames[27].get_coldata_header(3)->set_checksum_b(0);
+
+  wib::ColdataChecksumSummary summary;
+  BOOST_REQUIRE_EQUAL(summary.add(frames.data(), frames.size()), 3);
+  BOOST_REQUIRE_EQUAL(summary.get_links().size(), 2);
+
+  wib::WIBLinkID first{ 1, 2, 1 };
+  wib::WIBLinkID second{ 1, 3, 1 };
+  BOOST_REQUIRE(first < second);
+  auto counts = summary.get_counts(first);
+  BOOST_REQUIRE_EQUAL(counts.num_frames, 15);
+  BOOST_REQUIRE_EQUAL(counts.num_bad_frames, 2);
+  BOOST_REQUIRE_EQUAL(counts.num_bad_a, 2);
+  BOOST_REQUIRE_EQUAL(counts.num_bad_b, 1);
+  counts = summary.get_counts(second);
+  BOOST_REQUIRE_EQUAL(counts.num_frames, 15);
+  BOOST_REQUIRE_EQUAL(counts.num_bad_frames, 1);
+  BOOST_REQUIRE_EQUAL(counts.num_bad_b, 1);
+  BOOST_REQUIRE_EQUAL(summary.get_counts(wib::WIBLinkID{ 9, 9, 9 }).num_frames, 0);
+
+  wib::ColdataChecksumSummary other;
+  other.add(frames.data(), 5);
+  summary.merge(other);
+  auto total = summary.get_total();
+  BOOST_REQUIRE_EQUAL(total.num_frames, 35);
+  BOOST_REQUIRE_EQUAL(total.num_bad_frames, 4);
+  BOOST_REQUIRE_EQUAL(total.num_bad_a, 4);
+  BOOST_REQUIRE_EQUAL(total.num_bad_b, 2);
+
+  summary.clear();
+  BOOST_REQUIRE(summary.get_links().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,176 @@
+/**
+ * @file WIBErrorScan_test.cxx WIB header error scan Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBErrorScan.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE WIBErrorScan_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+/**
+ * @brief Frames of one link with random ADC values, random non-error header fields and no error field set
+ */
+std::vector<WIBFrame>
+make_clean_frames(size_t num_frames)
+{
+  std::vector<WIBFrame> frames(num_frames);
+  std::memset(frames.data(), 0, frames.size() * sizeof(WIBFrame));
+  std::mt19937 gen(24680);
+  std::uniform_int_distribution<int> adc(0, 0xFFF);
+  for (auto& frame : frames) {
+    frame.get_wib_header()->crate_no = 3;
+    frame.get_wib_header()->slot_no = 1;
+    frame.get_wib_header()->fiber_no = 2;
+    frame.get_wib_header()->reserved_2 = 0x3FFF;
+    frame.set_timestamp(adc(gen));
+    for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+      frame.get_coldata_header(block)->reserved_1 = 0xFF;
+      frame.get_coldata_header(block)->reserved_2 = 0xFFFF;
+      frame.get_coldata_header(block)->set_checksum_a(adc(gen));
+      frame.get_coldata_header(block)->set_checksum_b(adc(gen));
+      frame.get_coldata_header(block)->coldata_convert_count = adc(gen);
+    }
+    for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+      frame.set_channel(ch, adc(gen));
+    }
+  }
+  return frames;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(WIBErrorScan_test)
+
+BOOST_AUTO_TEST_CASE(CountsOfOneFrame)
+{
+  auto frame = make_clean_frames(1)[0];
+  wib::WIBErrorCounts counts;
+  BOOST_REQUIRE(!counts.add(frame));
+
+  frame.get_wib_header()->mm = 1;
+  frame.get_wib_header()->wib_errors = 0x8001;
+  frame.get_coldata_header(1)->s1_error = 0x4;
+  frame.get_coldata_header(2)->s2_error = 0x2;
+  frame.get_coldata_header(2)->error_register = 0x100;
+  frame.get_coldata_header(3)->error_register = 0x3;
+  BOOST_REQUIRE(counts.add(frame));
+
+  frame = make_clean_frames(1)[0];
+  frame.get_wib_header()->oos = 1;
+  BOOST_REQUIRE(counts.add(frame));
+
+  BOOST_REQUIRE_EQUAL(counts.num_frames, 3);
+  BOOST_REQUIRE_EQUAL(counts.num_frames_with_errors, 2);
+  BOOST_REQUIRE_EQUAL(counts.num_mm, 1);
+  BOOST_REQUIRE_EQUAL(counts.num_oos, 1);
+  BOOST_REQUIRE_EQUAL(counts.num_wib_errors, 1);
+  BOOST_REQUIRE_EQUAL(counts.num_s1_errors, 1);
+  BOOST_REQUIRE_EQUAL(counts.num_s2_errors, 1);
+  BOOST_REQUIRE_EQUAL(counts.num_error_registers, 2);
+  BOOST_REQUIRE_EQUAL(counts.wib_errors_or, 0x8001);
+  BOOST_REQUIRE_EQUAL(counts.error_register_or, 0x103);
+  BOOST_REQUIRE_EQUAL(counts.s1_error_or, 0x4);
+  BOOST_REQUIRE_EQUAL(counts.s2_error_or, 0x2);
+}
+
+BOOST_AUTO_TEST_CASE(SummaryMatchesFrameByFrame)
+{
+  // Sparse errors, some in the same block of frames and some alone, over runs from two links
+  auto frames = make_clean_frames(1000);
+  std::mt19937 gen(13579);
+  std::uniform_int_distribution<size_t> index(0, frames.size() - 1);
+  std::uniform_int_distribution<int> field(0, 5);
+  std::uniform_int_distribution<int> block(0, WIBFrame::s_num_block_per_frame - 1);
+  for (int i = 0; i < 20; ++i) {
+    auto& frame = frames[index(gen)];
+    switch (field(gen)) {
+      case 0: frame.get_wib_header()->mm = 1; break;
+      case 1: frame.get_wib_header()->oos = 1; break;
+      case 2: frame.get_wib_header()->wib_errors = 1 << block(gen); break;
+      case 3: frame.get_coldata_header(block(gen))->s1_error = 0x8; break;
+      case 4: frame.get_coldata_header(block(gen))->s2_error = 0x1; break;
+      default: frame.get_coldata_header(block(gen))->error_register = 0x40; break;
+    }
+  }
+  for (size_t i = 300; i < 700; ++i) {
+    frames[i].get_wib_header()->slot_no = 4;
+  }
+
+  wib::WIBErrorCounts first_reference;
+  wib::WIBErrorCounts second_reference;
+  size_t num_frames_with_errors = 0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    num_frames_with_errors += (i >= 300 && i < 700 ? second_reference : first_reference).add(frames[i]);
+  }
+  BOOST_REQUIRE_NE(num_frames_with_errors, 0);
+
+  wib::WIBErrorSummary summary;
+  BOOST_REQUIRE_EQUAL(summary.add(frames.data(), frames.size()), num_frames_with_errors);
+  BOOST_REQUIRE_EQUAL(summary.get_links().size(), 2);
+  const std::pair<wib::WIBLinkID, wib::WIBErrorCounts> references[] = { { { 3, 1, 2 }, first_reference },
+                                                                          { { 3, 4, 2 }, second_reference } };
+  for (auto& [link, reference] : references) {
+    auto counts = summary.get_counts(link);
+    BOOST_REQUIRE_EQUAL(counts.num_frames, reference.num_frames);
+    BOOST_REQUIRE_EQUAL(counts.num_frames_with_errors, reference.num_frames_with_errors);
+    BOOST_REQUIRE_EQUAL(counts.num_mm, reference.num_mm);
+    BOOST_REQUIRE_EQUAL(counts.num_oos, reference.num_oos);
+    BOOST_REQUIRE_EQUAL(counts.num_wib_errors, reference.num_wib_errors);
+    BOOST_REQUIRE_EQUAL(counts.num_s1_errors, reference.num_s1_errors);
+    BOOST_REQUIRE_EQUAL(counts.num_s2_errors, reference.num_s2_errors);
+    BOOST_REQUIRE_EQUAL(counts.num_error_registers, reference.num_error_registers);
+    BOOST_REQUIRE_EQUAL(counts.wib_errors_or, reference.wib_errors_or);
+    BOOST_REQUIRE_EQUAL(counts.error_register_or, reference.error_register_or);
+    BOOST_REQUIRE_EQUAL(counts.s1_error_or, reference.s1_error_or);
+    BOOST_REQUIRE_EQUAL(counts.s2_error_or, reference.s2_error_or);
+  }
+  BOOST_REQUIRE_EQUAL(summary.get_counts(wib::WIBLinkID{ 9, 9, 9 }).num_frames, 0);
+
+  wib::WIBErrorSummary other;
+  other.add(frames.data(), 10);
+  summary.merge(other);
+  BOOST_REQUIRE_EQUAL(summary.get_total().num_frames, frames.size() + 10);
+
+  summary.clear();
+  BOOST_REQUIRE(summary.get_links().empty());
+}
+
+BOOST_AUTO_TEST_CASE(Fragments)
+{
+  auto frames = make_clean_frames(100);
+  wib::WIBErrorSummary summary;
+  Fragment clean(frames.data(), frames.size() * sizeof(WIBFrame));
+  BOOST_REQUIRE_EQUAL(summary.add(clean, FragmentErrorBits::kUnassigned3), 0);
+  BOOST_REQUIRE(!clean.get_error_bit(FragmentErrorBits::kUnassigned3));
+
+  frames[57].get_coldata_header(0)->s2_error = 0x3;
+  Fragment with_errors(frames.data(), frames.size() * sizeof(WIBFrame));
+  BOOST_REQUIRE_EQUAL(summary.add(static_cast<const Fragment&>(with_errors)), 1);
+  BOOST_REQUIRE(!with_errors.get_error_bit(FragmentErrorBits::kUnassigned3));
+  BOOST_REQUIRE_EQUAL(summary.add(with_errors, FragmentErrorBits::kUnassigned3), 1);
+  BOOST_REQUIRE(with_errors.get_error_bit(FragmentErrorBits::kUnassigned3));
+
+  auto total = summary.get_total();
+  BOOST_REQUIRE_EQUAL(total.num_frames, 300);
+  BOOST_REQUIRE_EQUAL(total.num_frames_with_errors, 2);
+  BOOST_REQUIRE_EQUAL(total.s2_error_or, 0x3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -459,6 +459,34 @@ BOOST_AUTO_TEST_CASE(WIBFrame_BlockChannelMethods)
   BOOST_REQUIRE_EQUAL(block_3.get_channel(0, 0), 0x777);
   BOOST_REQUIRE_EQUAL(block_3.get_channel(1, 3), 0x888);
 }
+BOOST_AUTO_TEST_CASE(WIBFrame_UncheckedChannelMethods)
+{
+  WIBFrame frame;
+  for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+    frame.set_channel(ch, (ch * 37 + 11) & 0xFFF);
+  }
+
+  for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+    BOOST_REQUIRE_EQUAL(frame.get_channel_unchecked(ch), frame.get_channel(ch));
+  }
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    for (int adc = 0; adc < ColdataBlock::s_num_adc_per_block; ++adc) {
+      for (int ch = 0; ch < ColdataBlock::s_num_ch_per_adc; ++ch) {
+        uint16_t value = 0; // NOLINT(build/unsigned)
+        BOOST_REQUIRE(frame.try_get_channel(block, adc, ch, value));
+        BOOST_REQUIRE_EQUAL(value, frame.get_channel(block, adc, ch));
+        BOOST_REQUIRE_EQUAL(frame.get_channel_unchecked(block, adc, ch), value);
+        BOOST_REQUIRE_EQUAL(frame.get_block(block).get_channel_unchecked(adc, ch), value);
+      }
+    }
+  }
+
+  uint16_t value = 0x123; // NOLINT(build/unsigned)
+  BOOST_REQUIRE(!frame.try_get_channel(WIBFrame::s_num_block_per_frame, 0, value));
+  BOOST_REQUIRE(!frame.try_get_channel(0, ColdataBlock::s_num_adc_per_block, 0, value));
+  BOOST_REQUIRE(!frame.try_get_channel(0, 0, ColdataBlock::s_num_ch_per_block, value));
+  BOOST_REQUIRE_EQUAL(value, 0x123);
+}
 BOOST_AUTO_TEST_CASE(WIBFrame_StreamOperator)
 {
   WIBFrame frame;
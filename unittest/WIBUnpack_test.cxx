@@ -0,0 +1,183 @@
+/**
+ * @file WIBUnpack_test.cxx WIB bulk unpacker and packer Unit Tests
+ *
+ * This is part of the DUNE DAQ Application Framework, copyright 2020.
+ * Licensing/copyright details are in the COPYING file that you should have
+ * received with this code.
+ */
+
+#include "dataformats/wib/WIBUnpack.hpp"
+
+#include "RandomFrames.hpp"
+
+/**
+ * @brief Name of this test module
+ */
+#define BOOST_TEST_MODULE WIBUnpack_test // NOLINT
+
+#include "boost/test/unit_test.hpp"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dunedaq::dataformats;
+
+namespace {
+
+const std::vector<wib::UnpackImplementation> s_implementations = { wib::UnpackImplementation::kScalar,
+                                                                    wib::UnpackImplementation::kSSSE3,
+                                                                    wib::UnpackImplementation::kAVX2 };
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(WIBUnpack_test)
+
+BOOST_AUTO_TEST_CASE(ImplementationNames)
+{
+  BOOST_REQUIRE_EQUAL(std::string(wib::get_unpack_implementation_name(wib::UnpackImplementation::kScalar)), "scalar");
+  BOOST_REQUIRE_EQUAL(std::string(wib::get_unpack_implementation_name(wib::UnpackImplementation::kSSSE3)), "SSSE3");
+  BOOST_REQUIRE_EQUAL(std::string(wib::get_unpack_implementation_name(wib::UnpackImplementation::kAVX2)), "AVX2");
+
+  BOOST_REQUIRE(wib::is_unpack_implementation_supported(wib::UnpackImplementation::kScalar));
+  BOOST_REQUIRE(wib::is_unpack_implementation_supported(wib::get_best_unpack_implementation()));
+}
+
+BOOST_AUTO_TEST_CASE(MatchesGetChannel)
+{
+  const size_t num_frames = 17;
+  auto frames = make_random_frames<WIBFrame>(num_frames, 1234);
+  std::vector<adc_t> expected(num_frames * WIBFrame::s_num_ch_per_frame);
+  for (size_t i = 0; i < num_frames; ++i) {
+    for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+      expected[i * WIBFrame::s_num_ch_per_frame + ch] = frames[i].get_channel(ch);
+    }
+  }
+
+  for (auto implementation : s_implementations) {
+    if (!wib::is_unpack_implementation_supported(implementation)) {
+      BOOST_TEST_MESSAGE("Skipping unsupported implementation " << wib::get_unpack_implementation_name(implementation));
+      continue;
+    }
+    BOOST_TEST_MESSAGE("Checking implementation " << wib::get_unpack_implementation_name(implementation));
+    // One extra value at the end, which must not be written
+    std::vector<adc_t> adcs(expected.size() + 1, 0xDEAD);
+    wib::unpack_frames(frames.data(), num_frames, adcs.data(), implementation);
+    BOOST_REQUIRE_EQUAL(adcs.back(), 0xDEAD);
+    adcs.pop_back();
+    BOOST_REQUIRE(adcs == expected);
+  }
+
+  std::vector<adc_t> adcs(expected.size());
+  wib::unpack_frames(frames.data(), num_frames, adcs.data());
+  BOOST_REQUIRE(adcs == expected);
+
+  adcs.assign(WIBFrame::s_num_ch_per_frame, 0);
+  wib::unpack_frame(frames[3], adcs.data());
+  BOOST_REQUIRE(std::equal(adcs.begin(), adcs.end(), expected.begin() + 3 * WIBFrame::s_num_ch_per_frame));
+}
+
+BOOST_AUTO_TEST_CASE(MatchesSetChannel)
+{
+  WIBFrame frame;
+  std::memset(&frame, 0, sizeof(frame));
+  for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+    frame.set_channel(ch, (ch * 37 + 5) & 0xFFF);
+  }
+  std::vector<adc_t> adcs(WIBFrame::s_num_ch_per_frame);
+  wib::unpack_frame(frame, adcs.data());
+  for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+    BOOST_REQUIRE_EQUAL(adcs[ch], (ch * 37 + 5) & 0xFFF);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PackMatchesSetChannel)
+{
+  const size_t num_frames = 17;
+  auto reference = make_random_frames<WIBFrame>(num_frames, 1234);
+  // Full 16-bit values, of which set_channel and pack_frames keep the low 12 bits
+  std::vector<adc_t> values(num_frames * WIBFrame::s_num_ch_per_frame);
+  std::mt19937 gen(5678);
+  std::uniform_int_distribution<int> value(0, 0xFFFF);
+  for (auto& val : values) {
+    val = value(gen);
+  }
+  auto original = reference;
+  for (size_t i = 0; i < num_frames; ++i) {
+    for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+      reference[i].set_channel(ch, values[i * WIBFrame::s_num_ch_per_frame + ch]);
+    }
+  }
+
+  for (auto implementation : s_implementations) {
+    if (!wib::is_unpack_implementation_supported(implementation)) {
+      continue;
+    }
+    BOOST_TEST_MESSAGE("Checking implementation " << wib::get_unpack_implementation_name(implementation));
+    // One extra frame at the end, which must not be written
+    auto frames = original;
+    frames.push_back(original.front());
+    wib::pack_frames(values.data(), frames.data(), num_frames, implementation);
+    BOOST_REQUIRE_EQUAL(std::memcmp(&frames.back(), &original.front(), sizeof(WIBFrame)), 0);
+    BOOST_REQUIRE_EQUAL(std::memcmp(frames.data(), reference.data(), num_frames * sizeof(WIBFrame)), 0);
+  }
+
+  auto frames = original;
+  wib::pack_frames(values.data(), frames.data(), num_frames);
+  BOOST_REQUIRE_EQUAL(std::memcmp(frames.data(), reference.data(), num_frames * sizeof(WIBFrame)), 0);
+
+  // Headers are kept, so packing the values of frame 3 into frame 0 only changes the ADC values of frame 0
+  WIBFrame frame = original[0];
+  wib::pack_frame(values.data() + 3 * WIBFrame::s_num_ch_per_frame, frame);
+  BOOST_REQUIRE_EQUAL(std::memcmp(frame.get_wib_header(), original[0].get_wib_header(), sizeof(WIBHeader)), 0);
+  for (int block = 0; block < WIBFrame::s_num_block_per_frame; ++block) {
+    BOOST_REQUIRE_EQUAL(
+      std::memcmp(frame.get_coldata_header(block), original[0].get_coldata_header(block), sizeof(ColdataHeader)), 0);
+  }
+  for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+    BOOST_REQUIRE_EQUAL(frame.get_channel(ch), reference[3].get_channel(ch));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PackRoundTrip)
+{
+  const size_t num_frames = 5;
+  std::vector<adc_t> values(num_frames * WIBFrame::s_num_ch_per_frame);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = (i * 2654435761U >> 20) & 0xFFF;
+  }
+  std::vector<WIBFrame> frames(num_frames);
+  std::vector<adc_t> adcs(values.size());
+  for (auto implementation : s_implementations) {
+    if (!wib::is_unpack_implementation_supported(implementation)) {
+      continue;
+    }
+    std::memset(frames.data(), 0, num_frames * sizeof(WIBFrame));
+    wib::pack_frames(values.data(), frames.data(), num_frames, implementation);
+    wib::unpack_frames(frames.data(), num_frames, adcs.data(), implementation);
+    BOOST_REQUIRE(adcs == values);
+    for (int ch = 0; ch < WIBFrame::s_num_ch_per_frame; ++ch) {
+      BOOST_REQUIRE_EQUAL(frames[2].get_channel(ch), values[2 * WIBFrame::s_num_ch_per_frame + ch]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(UnsupportedImplementation)
+{
+  auto frames = make_random_frames<WIBFrame>(1, 1234);
+  std::vector<adc_t> adcs(WIBFrame::s_num_ch_per_frame);
+  for (auto implementation : s_implementations) {
+    if (wib::is_unpack_implementation_supported(implementation)) {
+      BOOST_REQUIRE_NO_THROW(wib::unpack_frames(frames.data(), 1, adcs.data(), implementation));
+      BOOST_REQUIRE_NO_THROW(wib::pack_frames(adcs.data(), frames.data(), 1, implementation));
+    } else {
+      BOOST_REQUIRE_THROW(wib::unpack_frames(frames.data(), 1, adcs.data(), implementation),
+                          WIBUnpackImplementationUnsupported);
+      BOOST_REQUIRE_THROW(wib::pack_frames(adcs.data(), frames.data(), 1, implementation),
+                          WIBUnpackImplementationUnsupported);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()